@@ -0,0 +1,281 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "msh/utils/buffer_pool.hpp"
+#include "msh/utils/byte_array.hpp"
+#include "msh/utils/byte_chain.hpp"
+#include "msh/utils/byte_reader.hpp"
+#include "msh/utils/byte_writer.hpp"
+#include "msh/utils/shared_bytes.hpp"
+
+using namespace msh::utils;
+
+namespace {
+
+ByteArray makePayload(const size_t size) {
+    ByteArray bytes(size);
+    for (size_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+    return bytes;
+}
+
+void BM_ByteArrayConstructFill(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        ByteArray bytes(size, 0xAB);
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ByteArrayConstructFill)->RangeMultiplier(8)->Range(8, 1 << 20);
+
+void BM_ByteArrayConstructCopy(benchmark::State& state) {
+    const auto source = makePayload(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        ByteArray bytes(source);
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ByteArrayConstructCopy)->RangeMultiplier(8)->Range(8, 1 << 20);
+
+// Appends 1 MiB in chunks of the given size to an empty array
+void BM_ByteArrayAppend(benchmark::State& state) {
+    const auto chunk = makePayload(static_cast<size_t>(state.range(0)));
+    const size_t total = 1 << 20;
+    for (auto _ : state) {
+        ByteArray bytes;
+        for (size_t written = 0; written < total; written += chunk.size()) {
+            bytes.append(chunk);
+        }
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * total);
+}
+BENCHMARK(BM_ByteArrayAppend)->RangeMultiplier(8)->Range(1, 1 << 16);
+
+void BM_ByteArrayToHex(benchmark::State& state) {
+    const auto bytes = makePayload(static_cast<size_t>(state.range(0)));
+    std::string hex;
+    for (auto _ : state) {
+        bytes.toHexString(hex);
+        benchmark::DoNotOptimize(hex.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ByteArrayToHex)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+void BM_ByteArrayFromHex(benchmark::State& state) {
+    const auto hex = makePayload(static_cast<size_t>(state.range(0))).toHexString();
+    for (auto _ : state) {
+        auto bytes = ByteArray::fromHexString(hex);
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ByteArrayFromHex)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+void BM_ByteArrayToBase64(benchmark::State& state) {
+    const auto bytes = makePayload(static_cast<size_t>(state.range(0)));
+    std::string text;
+    for (auto _ : state) {
+        bytes.toBase64String(text);
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ByteArrayToBase64)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+void BM_ByteArrayFromBase64(benchmark::State& state) {
+    const auto text = makePayload(static_cast<size_t>(state.range(0))).toBase64String();
+    for (auto _ : state) {
+        auto bytes = ByteArray::fromBase64String(text);
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ByteArrayFromBase64)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+void BM_ByteArrayToBase32(benchmark::State& state) {
+    const auto bytes = makePayload(static_cast<size_t>(state.range(0)));
+    std::string text;
+    for (auto _ : state) {
+        bytes.toBase32String(text);
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ByteArrayToBase32)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+void BM_ByteArrayToZ85(benchmark::State& state) {
+    const auto bytes = makePayload(static_cast<size_t>(state.range(0)));
+    std::string text;
+    for (auto _ : state) {
+        bytes.toZ85String(text);
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ByteArrayToZ85)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+// Packet-sized buffers created and destroyed per iteration, through the default allocator or the
+// pool; run with several threads to see allocator contention
+void BM_ByteArrayChurnDefault(benchmark::State& state) {
+    for (auto _ : state) {
+        ByteArray bytes;
+        bytes.resize(static_cast<size_t>(state.range(0)));
+        benchmark::DoNotOptimize(bytes.data());
+    }
+}
+BENCHMARK(BM_ByteArrayChurnDefault)->Arg(1500)->Arg(16384)->ThreadRange(1, 8);
+
+void BM_ByteArrayChurnPool(benchmark::State& state) {
+    for (auto _ : state) {
+        ByteArray bytes(&BufferPool::instance());
+        bytes.resize(static_cast<size_t>(state.range(0)));
+        benchmark::DoNotOptimize(bytes.data());
+    }
+}
+BENCHMARK(BM_ByteArrayChurnPool)->Arg(1500)->Arg(16384)->ThreadRange(1, 8);
+
+// One payload handed to three consumers, by deep copy or by sharing
+void BM_FanOutCopy(benchmark::State& state) {
+    const auto payload = makePayload(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        ByteArray logger(payload);
+        ByteArray persister(payload);
+        ByteArray forwarder(payload);
+        benchmark::DoNotOptimize(forwarder.data());
+    }
+}
+BENCHMARK(BM_FanOutCopy)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+void BM_FanOutShared(benchmark::State& state) {
+    const SharedBytes payload(makePayload(static_cast<size_t>(state.range(0))));
+    for (auto _ : state) {
+        SharedBytes logger(payload);
+        SharedBytes persister(payload);
+        SharedBytes forwarder(payload);
+        benchmark::DoNotOptimize(forwarder.data());
+    }
+}
+BENCHMARK(BM_FanOutShared)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+// A header and trailer framed around a body, by concatenation or by chaining
+void BM_FrameConcat(benchmark::State& state) {
+    const auto body = makePayload(static_cast<size_t>(state.range(0)));
+    const auto header = makePayload(16);
+    const auto trailer = makePayload(4);
+    for (auto _ : state) {
+        ByteArray frame(header);
+        frame.append(body);
+        frame.append(trailer);
+        benchmark::DoNotOptimize(frame.data());
+    }
+}
+BENCHMARK(BM_FrameConcat)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+void BM_FrameChain(benchmark::State& state) {
+    const auto body = makePayload(static_cast<size_t>(state.range(0)));
+    const auto header = makePayload(16);
+    const auto trailer = makePayload(4);
+    std::vector<ByteView> views;
+    for (auto _ : state) {
+        ByteChain frame;
+        frame.appendRef(body);
+        frame.prependCopy(header);
+        frame.appendCopy(trailer);
+        frame.views(views);
+        benchmark::DoNotOptimize(views.data());
+    }
+}
+BENCHMARK(BM_FrameChain)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+// Records of a big-endian u32, u16 and varint, packed a byte at a time or with ByteWriter
+void BM_PackFieldsByHand(benchmark::State& state) {
+    const auto count = static_cast<uint32_t>(state.range(0));
+    ByteArray out;
+    for (auto _ : state) {
+        out.clear();
+        for (uint32_t i = 0; i < count; ++i) {
+            for (int shift = 24; shift >= 0; shift -= 8) {
+                out.insert(out.end(), static_cast<uint8_t>(i >> shift));
+            }
+            out.insert(out.end(), static_cast<uint8_t>(i >> 8));
+            out.insert(out.end(), static_cast<uint8_t>(i));
+            uint32_t value = i * 37;
+            while (value >= 0x80) {
+                out.insert(out.end(), static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.insert(out.end(), static_cast<uint8_t>(value));
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_PackFieldsByHand)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+void BM_PackFieldsWriter(benchmark::State& state) {
+    const auto count = static_cast<uint32_t>(state.range(0));
+    ByteArray out;
+    for (auto _ : state) {
+        out.clear();
+        ByteWriter writer(out, endian::Order::Big);
+        for (uint32_t i = 0; i < count; ++i) {
+            writer.write(i);
+            writer.write(static_cast<uint16_t>(i));
+            writer.writeVarint(i * 37);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_PackFieldsWriter)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+void BM_UnpackFieldsReader(benchmark::State& state) {
+    const auto count = static_cast<uint32_t>(state.range(0));
+    ByteArray encoded;
+    ByteWriter writer(encoded, endian::Order::Big);
+    for (uint32_t i = 0; i < count; ++i) {
+        writer.write(i);
+        writer.write(static_cast<uint16_t>(i));
+        writer.writeVarint(i * 37);
+    }
+    for (auto _ : state) {
+        ByteReader reader(encoded, endian::Order::Big);
+        uint64_t sum = 0;
+        while (!reader.atEnd()) {
+            sum += reader.read<uint32_t>();
+            sum += reader.read<uint16_t>();
+            sum += reader.readVarint();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_UnpackFieldsReader)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+// Converting an array of integers to the other byte order
+void BM_WriteArraySwapped(benchmark::State& state) {
+    std::vector<uint32_t> values(static_cast<size_t>(state.range(0)));
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<uint32_t>(i * 2654435761u);
+    }
+    const auto swapped =
+        endian::native == endian::Order::Little ? endian::Order::Big : endian::Order::Little;
+    ByteArray out;
+    for (auto _ : state) {
+        out.clear();
+        ByteWriter(out, swapped).writeArray(values.data(), values.size());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0) * 4);
+}
+BENCHMARK(BM_WriteArraySwapped)->RangeMultiplier(16)->Range(16, 1 << 18);
+
+}  // namespace
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "msh/utils/byte_array.hpp"
+#include "msh/utils/byte_view.hpp"
+
+using namespace msh::utils;
+
+namespace {
+
+// Text-like bytes without the delimiters searched for, which are placed at the end
+ByteArray makeText(const size_t size) {
+    ByteArray bytes(size);
+    for (size_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<uint8_t>('a' + (i * 7) % 26);
+    }
+    if (size >= 4) {
+        bytes[size - 4] = '\r';
+        bytes[size - 3] = '\n';
+        bytes[size - 2] = '\r';
+        bytes[size - 1] = '\n';
+    }
+    return bytes;
+}
+
+void BM_FindAny(benchmark::State& state) {
+    const auto text = makeText(static_cast<size_t>(state.range(0)));
+    const ByteArray delimiters = {'\r', '\n', ';', ' '};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(text.find_any(delimiters));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_FindAny)->RangeMultiplier(8)->Range(64, 1 << 20);
+
+// Baseline: the loop a protocol parser would otherwise write
+void BM_FindAnyNaive(benchmark::State& state) {
+    const auto text = makeText(static_cast<size_t>(state.range(0)));
+    const ByteArray delimiters = {'\r', '\n', ';', ' '};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::find_first_of(text.begin(), text.end(),
+                                                    delimiters.begin(), delimiters.end()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_FindAnyNaive)->RangeMultiplier(8)->Range(64, 1 << 20);
+
+void BM_FindPattern(benchmark::State& state) {
+    const auto text = makeText(static_cast<size_t>(state.range(0)));
+    const ByteArray pattern = {'\r', '\n', '\r', '\n'};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(text.find(pattern));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_FindPattern)->RangeMultiplier(8)->Range(64, 1 << 20);
+
+void BM_FindPatternStdSearch(benchmark::State& state) {
+    const auto text = makeText(static_cast<size_t>(state.range(0)));
+    const ByteArray pattern = {'\r', '\n', '\r', '\n'};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            std::search(text.begin(), text.end(), pattern.begin(), pattern.end()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_FindPatternStdSearch)->RangeMultiplier(8)->Range(64, 1 << 20);
+
+void BM_Rfind(benchmark::State& state) {
+    auto text = makeText(static_cast<size_t>(state.range(0)));
+    text[0] = '#';
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(text.rfind('#'));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Rfind)->RangeMultiplier(8)->Range(64, 1 << 20);
+
+}  // namespace
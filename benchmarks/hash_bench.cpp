@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "msh/utils/byte_array.hpp"
+#include "msh/utils/hash.hpp"
+
+using namespace msh::utils;
+
+namespace {
+
+ByteArray makePayload(const size_t size) {
+    ByteArray bytes(size);
+    for (size_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+    return bytes;
+}
+
+void BM_Hash64(benchmark::State& state) {
+    const auto bytes = makePayload(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hash::hash64(bytes.data(), bytes.size()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Hash64)->RangeMultiplier(8)->Range(8, 1 << 20);
+
+// Baseline: the standard library's string hash over the same bytes
+void BM_StdHashStringView(benchmark::State& state) {
+    const auto bytes = makePayload(static_cast<size_t>(state.range(0)));
+    const std::string_view view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::hash<std::string_view>()(view));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_StdHashStringView)->RangeMultiplier(8)->Range(8, 1 << 20);
+
+void BM_Crc32c(benchmark::State& state) {
+    const auto bytes = makePayload(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hash::crc32c(bytes.data(), bytes.size()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Crc32c)->RangeMultiplier(8)->Range(64, 1 << 20);
+
+void BM_Crc32cTable(benchmark::State& state) {
+    const auto bytes = makePayload(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hash::detail::crc32cScalar(~0u, bytes.data(), bytes.size()));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Crc32cTable)->RangeMultiplier(8)->Range(64, 1 << 20);
+
+}  // namespace
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "msh/utils/JsonConfig.hpp"
+#include "msh/utils/config_keys.hpp"
+
+using namespace msh::utils;
+
+namespace {
+
+// A flat object of 64 integer keys, similar in shape to a feature-flag config
+const nlohmann::json& config() {
+    static const nlohmann::json j = [] {
+        nlohmann::json object = nlohmann::json::object();
+        for (int i = 0; i < 64; ++i) {
+            object["key_" + std::to_string(i)] = i;
+        }
+        return object;
+    }();
+    return j;
+}
+
+std::vector<std::string> keys(const char* prefix) {
+    std::vector<std::string> result;
+    for (int i = 0; i < 64; ++i) {
+        result.push_back(prefix + std::to_string(i));
+    }
+    return result;
+}
+
+void BM_GetSafeHit(benchmark::State& state) {
+    const auto names = keys("key_");
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(JsonConfig::getSafe(config(), names[i++ & 63], int32_t{}));
+    }
+}
+BENCHMARK(BM_GetSafeHit);
+
+// Literal keys take the string_view path without building a std::string
+void BM_GetSafeHitLiteral(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(JsonConfig::getSafe(config(), "key_42", int32_t{}));
+    }
+}
+BENCHMARK(BM_GetSafeHitLiteral);
+
+void BM_GetSafeMiss(benchmark::State& state) {
+    const auto names = keys("missing_");
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(JsonConfig::getSafe(config(), names[i++ & 63], int32_t{}));
+    }
+}
+BENCHMARK(BM_GetSafeMiss);
+
+void BM_GetSafeTypeMismatch(benchmark::State& state) {
+    const auto names = keys("key_");
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(JsonConfig::getSafe(config(), names[i++ & 63], std::string()));
+    }
+}
+BENCHMARK(BM_GetSafeTypeMismatch);
+
+// Mixed workload where the argument is the percentage of lookups that miss
+void BM_GetSafeMissRate(benchmark::State& state) {
+    const auto hits = keys("key_");
+    const auto misses = keys("missing_");
+    std::vector<const std::string*> names;
+    for (size_t i = 0; i < 100; ++i) {
+        names.push_back(static_cast<int64_t>(i) < state.range(0) ? &misses[i & 63] : &hits[i & 63]);
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(JsonConfig::getSafe(config(), *names[i], int32_t{}));
+        i = i == 99 ? 0 : i + 1;
+    }
+}
+BENCHMARK(BM_GetSafeMissRate)->Arg(0)->Arg(10)->Arg(50)->Arg(100);
+
+// Precomputed handles: the lookup is a load from the resolved table
+void BM_KeyGet(benchmark::State& state) {
+    JsonConfig::KeySet key_set;
+    std::vector<JsonConfig::Key<int32_t>> handles;
+    for (const auto& name : keys("key_")) {
+        handles.push_back(key_set.add<int32_t>(name, 0));
+    }
+    const auto values = key_set.resolve(config());
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(values[handles[i++ & 63]]);
+    }
+}
+BENCHMARK(BM_KeyGet);
+
+}  // namespace
@@ -2,148 +2,807 @@
 
 #include <plog/Log.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
 #include <nlohmann/json.hpp>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "byte_array.hpp"
 
 namespace msh::utils {
 
 namespace JsonConfig {
 using json = nlohmann::json;
 
-template <typename T>
-inline T getSafe(const json& j, const std::string& key, const T& default_value);
+/**
+ * @brief A problem found while reading a config value
+ */
+struct Issue {
+    enum class Kind { Missing, Null, InvalidType, OutOfRange, ConversionFailed };
+    static constexpr size_t kind_count = 5;
 
-template <typename T>
-inline T getSafe(const json& j, const std::string& key);
+    std::string key;
+    Kind kind;
+    /// Offending value, empty for Missing
+    std::string value;
+};
 
-template <typename T>
-T getSafe(const json& j, const std::string& key, const T& default_value) {
-    if (!j.contains(key)) {
-        if constexpr (std::is_enum_v<T>) {
-            PLOG_WARNING << "j[\"" << key << "\"] is not available & default value set: \""
-                         << static_cast<std::underlying_type_t<T>>(default_value) << "\"";
-        } else {
-            PLOG_WARNING << "j[\"" << key << "\"] is not available & default value set: \""
-                         << default_value << "\"";
+inline const char* toString(const Issue::Kind kind) {
+    switch (kind) {
+        case Issue::Kind::Missing: return "missing";
+        case Issue::Kind::Null: return "null";
+        case Issue::Kind::InvalidType: return "invalid type";
+        case Issue::Kind::OutOfRange: return "out of range";
+        case Issue::Kind::ConversionFailed: return "conversion failed";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Issues collected by Schema::bind or by getSafe in Collect mode; the affected values got
+ * their default
+ */
+struct Report {
+    std::vector<Issue> issues;
+
+    bool ok() const noexcept {
+        return issues.empty();
+    }
+
+    /**
+     * @brief One line listing every issue, suitable for a single log message
+     */
+    std::string toString() const {
+        std::ostringstream out;
+        for (size_t i = 0; i < issues.size(); ++i) {
+            if (i != 0) {
+                out << "; ";
+            }
+            out << "j[\"" << issues[i].key << "\"] " << JsonConfig::toString(issues[i].kind);
+            if (!issues[i].value.empty()) {
+                out << ": " << issues[i].value;
+            }
         }
-        return default_value;
+        return out.str();
     }
+};
 
-    const auto& jvalue = j[key];
+/**
+ * @brief How getSafe reports missing, null and mistyped values
+ *
+ * Every failure is counted per key and kind whatever the mode; the mode only decides whether a
+ * message is produced. Values are dumped only for messages that are actually emitted.
+ */
+struct DiagnosticsPolicy {
+    enum class Mode {
+        Always,       ///< Log every failure
+        OncePerKey,   ///< Log the first failure of each key
+        RateLimited,  ///< Log at most once per key and interval, noting how many were suppressed
+        Collect,      ///< Append an Issue to report, once per key and kind, instead of logging
+        Silent,       ///< Only update the counters
+    };
 
-    if (jvalue.is_null()) {
-        if constexpr (std::is_enum_v<T>) {
-            PLOG_WARNING << "j[\"" << key << "\"] is null & default value set: \""
-                         << static_cast<std::underlying_type_t<T>>(default_value) << "\"";
-            return default_value;
+    Mode mode = Mode::Always;
+    /// Minimum time between two messages of the same key in RateLimited mode
+    std::chrono::milliseconds interval{1000};
+    /// Receives the issues in Collect mode; getSafe appends under a lock, so concurrent readers
+    /// may share it, but read it only once they are done
+    Report* report = nullptr;
+};
+
+/**
+ * @brief Failure counters of one key, for metrics export
+ */
+struct KeyDiagnostics {
+    std::string key;
+    std::array<uint64_t, Issue::kind_count> counts{};
+    /// Failures that produced a message or added an issue to a report
+    uint64_t emitted = 0;
+
+    uint64_t count(const Issue::Kind kind) const noexcept {
+        return counts[static_cast<size_t>(kind)];
+    }
+
+    uint64_t total() const noexcept {
+        uint64_t sum = 0;
+        for (const auto count : counts) {
+            sum += count;
+        }
+        return sum;
+    }
+};
+
+namespace detail {
+
+// Dumps a value for a log message, cut short so a large subtree cannot flood the log
+inline std::string dumpForLog(const json& jvalue) {
+    constexpr size_t max_length = 256;
+    std::string text = jvalue.dump();
+    if (text.size() > max_length) {
+        text.resize(max_length);
+        text += "...";
+    }
+    return text;
+}
+
+/**
+ * @brief Process-wide failure counters and emission state, sharded by key to limit contention
+ */
+class Diagnostics {
+  public:
+    static Diagnostics& instance() {
+        static Diagnostics diagnostics;
+        return diagnostics;
+    }
+
+    // The global policy is read on every getSafe failure, so its fields are atomics rather than
+    // a locked struct; a reader racing setPolicy may see a mix of the old and new fields
+    void setPolicy(const DiagnosticsPolicy& policy) noexcept {
+        m_interval.store(policy.interval.count(), std::memory_order_relaxed);
+        m_report.store(policy.report, std::memory_order_relaxed);
+        m_mode.store(policy.mode, std::memory_order_release);
+    }
+
+    DiagnosticsPolicy policy() const noexcept {
+        DiagnosticsPolicy policy;
+        policy.mode = m_mode.load(std::memory_order_acquire);
+        policy.interval = std::chrono::milliseconds(m_interval.load(std::memory_order_relaxed));
+        policy.report = m_report.load(std::memory_order_relaxed);
+        return policy;
+    }
+
+    /**
+     * @brief Count a failure and decide whether it is emitted under policy
+     *
+     * In Collect mode the issue is added to the report here, and only if the report has none for
+     * the same key and kind, so a failure repeated in a loop adds one entry.
+     *
+     * @param jvalue The offending value, nullptr if it is missing
+     * @param suppressed Receives the number of failures of this key dropped since the last
+     * emitted one
+     * @return True if a message or issue should be produced
+     */
+    bool record(const std::string_view key,
+                const Issue::Kind kind,
+                const json* jvalue,
+                const DiagnosticsPolicy& policy,
+                uint64_t& suppressed) {
+        Shard& shard = m_shards[std::hash<std::string_view>{}(key) % shard_count];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.keys.find(key);
+        if (it == shard.keys.end()) {
+            it = shard.keys.emplace(std::string(key), KeyState{}).first;
+        }
+        KeyState& state = it->second;
+        ++state.counts[static_cast<size_t>(kind)];
+
+        bool emit = false;
+        switch (policy.mode) {
+            case DiagnosticsPolicy::Mode::Always: emit = true; break;
+            case DiagnosticsPolicy::Mode::Collect:
+                emit = collect(policy.report, key, kind, jvalue);
+                break;
+            case DiagnosticsPolicy::Mode::OncePerKey: emit = state.emitted == 0; break;
+            case DiagnosticsPolicy::Mode::RateLimited: {
+                const auto now = std::chrono::steady_clock::now();
+                emit = state.emitted == 0 || now - state.lastEmitted >= policy.interval;
+                if (emit) {
+                    state.lastEmitted = now;
+                }
+                break;
+            }
+            case DiagnosticsPolicy::Mode::Silent: break;
+        }
+
+        if (emit) {
+            ++state.emitted;
+            suppressed = state.suppressed;
+            state.suppressed = 0;
         } else {
-            PLOG_WARNING << "j[\"" << key << "\"] is null & default value set: \"" << default_value
-                         << "\"";
-            return default_value;
+            ++state.suppressed;
+        }
+        return emit;
+    }
+
+    std::vector<KeyDiagnostics> snapshot() const {
+        std::vector<KeyDiagnostics> result;
+        for (const Shard& shard : m_shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (const auto& [key, state] : shard.keys) {
+                result.push_back({key, state.counts, state.emitted});
+            }
+        }
+        std::sort(result.begin(), result.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.key < rhs.key;
+        });
+        return result;
+    }
+
+    void reset() {
+        for (Shard& shard : m_shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.keys.clear();
         }
     }
 
+  private:
+    struct KeyState {
+        std::array<uint64_t, Issue::kind_count> counts{};
+        uint64_t emitted = 0;
+        uint64_t suppressed = 0;
+        std::chrono::steady_clock::time_point lastEmitted;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::map<std::string, KeyState, std::less<>> keys;
+    };
+
+    static constexpr size_t shard_count = 16;
+
+    std::array<Shard, shard_count> m_shards;
+    std::atomic<DiagnosticsPolicy::Mode> m_mode{DiagnosticsPolicy::Mode::Always};
+    std::atomic<std::chrono::milliseconds::rep> m_interval{
+        DiagnosticsPolicy{}.interval.count()};
+    std::atomic<Report*> m_report{nullptr};
+    // Serializes appends to reports, which keys of different shards may share
+    std::mutex m_reportMutex;
+
+    // Adds an issue to report unless it already has one for key and kind
+    bool collect(Report* report,
+                 const std::string_view key,
+                 const Issue::Kind kind,
+                 const json* jvalue) {
+        if (report == nullptr) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(m_reportMutex);
+        for (const Issue& issue : report->issues) {
+            if (issue.kind == kind && issue.key == key) {
+                return false;
+            }
+        }
+        report->issues.push_back(
+            {std::string(key), kind, jvalue != nullptr ? dumpForLog(*jvalue) : std::string()});
+        return true;
+    }
+};
+
+/**
+ * @brief Count a getSafe failure and emit it according to the policy
+ * @param policy Per-call policy, nullptr for the global one
+ * @param message Builds the log message; only called when a message is emitted
+ */
+template <typename Message>
+void report(const std::string_view key,
+            const Issue::Kind kind,
+            const json* jvalue,
+            const DiagnosticsPolicy* policy,
+            const Message& message) {
+    auto& diagnostics = Diagnostics::instance();
+    const DiagnosticsPolicy effective = policy != nullptr ? *policy : diagnostics.policy();
+
+    uint64_t suppressed = 0;
+    if (!diagnostics.record(key, kind, jvalue, effective, suppressed) ||
+        effective.mode == DiagnosticsPolicy::Mode::Collect) {
+        return;
+    }
+
+    if (suppressed != 0) {
+        PLOG_WARNING << message() << " (" << suppressed << " similar suppressed)";
+    } else {
+        PLOG_WARNING << message();
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Set the policy used by getSafe calls that do not pass one
+ */
+inline void setDiagnosticsPolicy(const DiagnosticsPolicy& policy) {
+    detail::Diagnostics::instance().setPolicy(policy);
+}
+
+inline DiagnosticsPolicy diagnosticsPolicy() {
+    return detail::Diagnostics::instance().policy();
+}
+
+/**
+ * @brief Snapshot of the failure counters of every key seen so far, sorted by key
+ */
+inline std::vector<KeyDiagnostics> diagnostics() {
+    return detail::Diagnostics::instance().snapshot();
+}
+
+/**
+ * @brief Clear all counters, also re-arming OncePerKey and RateLimited messages
+ */
+inline void resetDiagnostics() {
+    detail::Diagnostics::instance().reset();
+}
+
+/**
+ * @brief RFC 6901 pointer kept as its string, e.g. constexpr Pointer server_port{"/server/port"}
+ *
+ * Unlike json::json_pointer it is not split into tokens, so it can be a constant and getSafe
+ * walks it in place. The text must outlive the call.
+ */
+struct Pointer {
+    std::string_view text;
+};
+
+namespace detail {
+
+// Keeps a parameter out of template argument deduction, so literals convert to the member type
+template <typename T>
+using identity_t = typename std::common_type<T>::type;
+
+enum class ConvertStatus { Ok, InvalidType, OutOfRange, ConversionFailed };
+
+/**
+ * @brief Convert a non-null JSON value to T with the same rules as getSafe
+ * @param jvalue Value to convert
+ * @param out Receives the converted value, untouched on failure
+ * @param what Receives the reason when an enum conversion throws or a base64 string is malformed,
+ * may be null
+ */
+template <typename T>
+ConvertStatus convert(const json& jvalue, T& out, std::string* what = nullptr) {
     if constexpr (std::is_enum_v<T>) {
         if (jvalue.is_string()) {
             try {
-                return jvalue.get<T>();
+                out = jvalue.get<T>();
+                return ConvertStatus::Ok;
             } catch (const std::exception& e) {
-                PLOG_WARNING << "j[\"" << key.c_str() << "\"] enum conversion failed: " << e.what()
-                             << " | value: \"" << jvalue.dump() << "\"";
+                if (what != nullptr) {
+                    *what = e.what();
+                }
+                return ConvertStatus::ConversionFailed;
             }
-            return default_value;
         }
     } else if constexpr (std::is_same_v<T, bool>) {
         if (jvalue.is_boolean()) {
-            return jvalue.get<T>();
+            out = jvalue.get<T>();
+            return ConvertStatus::Ok;
         }
     } else if constexpr (std::is_integral_v<T>) {
         if (jvalue.is_number_integer()) {
             auto value = jvalue.get<int64_t>();
             if (value >= static_cast<int64_t>(std::numeric_limits<T>::min()) &&
                 value <= static_cast<int64_t>(std::numeric_limits<T>::max())) {
-                return static_cast<T>(value);
-            } else {
-                return default_value;
+                out = static_cast<T>(value);
+                return ConvertStatus::Ok;
             }
+            return ConvertStatus::OutOfRange;
         }
     } else if constexpr (std::is_floating_point_v<T>) {
         if (jvalue.is_number_float()) {
-            return jvalue.get<T>();
+            out = jvalue.get<T>();
+            return ConvertStatus::Ok;
         }
     } else if constexpr (std::is_same_v<T, std::string>) {
         if (jvalue.is_string()) {
-            return jvalue.get<T>();
+            out = jvalue.get<T>();
+            return ConvertStatus::Ok;
+        }
+    } else if constexpr (std::is_same_v<T, ByteArray>) {
+        // Binary values are base64 strings, in either alphabet and with or without padding
+        if (jvalue.is_string()) {
+            const auto& text = jvalue.get_ref<const json::string_t&>();
+            auto bytes = ByteArray::tryFromBase64String(text);
+            if (!bytes) {
+                bytes = ByteArray::tryFromBase64String(text, base64::Alphabet::Url);
+            }
+            if (bytes) {
+                out = std::move(*bytes);
+                return ConvertStatus::Ok;
+            }
+            if (what != nullptr) {
+                *what = "invalid base64";
+            }
+            return ConvertStatus::ConversionFailed;
         }
     }
+    return ConvertStatus::InvalidType;
+}
 
-    PLOG_WARNING << "j[\"" << key << "\"] has invalid type: \"" << jvalue.type_name()
-                 << "\" & value: \"" << jvalue.dump() << "\"";
-    return default_value;
+/**
+ * @brief Look up a member of an object with a single search
+ * @return The member, or nullptr if j is not an object or has no such key
+ */
+inline const json* findMember(const json& j, const std::string_view key) {
+    if (!j.is_object()) {
+        return nullptr;
+    }
+    const auto& object = j.get_ref<const json::object_t&>();
+#if NLOHMANN_JSON_VERSION_MAJOR > 3 || \
+    (NLOHMANN_JSON_VERSION_MAJOR == 3 && NLOHMANN_JSON_VERSION_MINOR >= 11)
+    // The default object comparator is transparent, so the view is searched without a copy
+    const auto it = object.find(key);
+#else
+    const auto it = object.find(std::string(key));
+#endif
+    return it != object.end() ? &it->second : nullptr;
 }
 
-template <typename T>
-T getSafe(const json& j, const std::string& key) {
-    if (!j.contains(key)) {
-        if constexpr (std::is_enum_v<T>) {
-            PLOG_WARNING << "j[\"" << key << "\"] is not available & default value set: \""
-                         << static_cast<std::underlying_type_t<T>>(T{}) << "\"";
+/**
+ * @brief Resolve an RFC 6901 pointer in one walk, with one search per reference token
+ * @return The referenced value, or nullptr if the pointer is malformed or any token does not
+ * resolve
+ */
+inline const json* findPointer(const json& j, const std::string_view pointer) {
+    const json* current = &j;
+    std::string unescaped;
+    size_t pos = 0;
+    while (pos < pointer.size()) {
+        // Every token is preceded by '/'
+        if (pointer[pos] != '/') {
+            return nullptr;
+        }
+        const size_t begin = pos + 1;
+        const size_t slash = pointer.find('/', begin);
+        pos = slash == std::string_view::npos ? pointer.size() : slash;
+        std::string_view token = pointer.substr(begin, pos - begin);
+
+        if (token.find('~') != std::string_view::npos) {
+            unescaped.clear();
+            for (size_t i = 0; i < token.size(); ++i) {
+                if (token[i] == '~') {
+                    if (i + 1 == token.size() || (token[i + 1] != '0' && token[i + 1] != '1')) {
+                        return nullptr;
+                    }
+                    unescaped += token[++i] == '1' ? '/' : '~';
+                } else {
+                    unescaped += token[i];
+                }
+            }
+            token = unescaped;
+        }
+
+        if (current->is_object()) {
+            current = findMember(*current, token);
+        } else if (current->is_array()) {
+            size_t index = 0;
+            if (token.empty() || (token.size() > 1 && token[0] == '0')) {
+                return nullptr;
+            }
+            for (const char c : token) {
+                if (c < '0' || c > '9') {
+                    return nullptr;
+                }
+                const auto digit = static_cast<size_t>(c - '0');
+                // An index that does not fit size_t is past the end of any array
+                if (index > (std::numeric_limits<size_t>::max() - digit) / 10) {
+                    return nullptr;
+                }
+                index = index * 10 + digit;
+            }
+            if (index >= current->size()) {
+                return nullptr;
+            }
+            current = &(*current)[index];
         } else {
-            PLOG_WARNING << "j[\"" << key << "\"] is not available & default value set: \"" << T{}
-                         << "\"";
+            return nullptr;
         }
-        return T{};
-    }
 
-    const auto& jvalue = j[key];
+        if (current == nullptr) {
+            return nullptr;
+        }
+    }
+    return current;
+}
 
-    if (jvalue.is_null()) {
+/**
+ * @brief Shared body of the getSafe overloads once the value has been looked up
+ * @param jvalue The value, nullptr if it is not available
+ * @param key Key or pointer used in diagnostics
+ * @param policy Per-call diagnostics policy, nullptr for the global one
+ */
+template <typename T>
+T getSafe(const json* jvalue,
+          const std::string_view key,
+          const T& default_value,
+          const DiagnosticsPolicy* policy) {
+    // Streams the default, enums as their underlying value
+    const auto defaultText = [&default_value]() {
+        std::ostringstream out;
         if constexpr (std::is_enum_v<T>) {
-            PLOG_WARNING << "j[\"" << key << "\"] is null & default value set: \""
-                         << static_cast<std::underlying_type_t<T>>(T{}) << "\"";
+            out << static_cast<std::underlying_type_t<T>>(default_value);
+        } else if constexpr (std::is_same_v<T, ByteArray>) {
+            out << default_value.toBase64String();
         } else {
-            PLOG_WARNING << "j[\"" << key << "\"] is null & default value set: \"" << T{} << "\"";
+            out << default_value;
         }
-        return T{};
+        return out.str();
+    };
+
+    if (jvalue == nullptr) {
+        report(key, Issue::Kind::Missing, jvalue, policy, [&]() {
+            return "j[\"" + std::string(key) + "\"] is not available & default value set: \"" +
+                   defaultText() + "\"";
+        });
+        return default_value;
     }
 
-    if constexpr (std::is_enum_v<T>) {
-        if (jvalue.is_string()) {
-            try {
-                return jvalue.get<T>();
-            } catch (const std::exception& e) {
-                PLOG_WARNING << "j[\"" << key.c_str() << "\"] enum conversion failed: " << e.what()
-                             << " | value: \"" << jvalue.dump() << "\"";
+    if (jvalue->is_null()) {
+        report(key, Issue::Kind::Null, jvalue, policy, [&]() {
+            return "j[\"" + std::string(key) + "\"] is null & default value set: \"" +
+                   defaultText() + "\"";
+        });
+        return default_value;
+    }
+
+    T value = default_value;
+    std::string what;
+    switch (convert(*jvalue, value, &what)) {
+        case ConvertStatus::Ok: return value;
+        case ConvertStatus::OutOfRange:
+            report(key, Issue::Kind::OutOfRange, jvalue, policy, [&]() {
+                return "j[\"" + std::string(key) + "\"] is out of range & default value set: \"" +
+                       defaultText() + "\" | value: \"" + dumpForLog(*jvalue) + "\"";
+            });
+            return default_value;
+        case ConvertStatus::ConversionFailed:
+            report(key, Issue::Kind::ConversionFailed, jvalue, policy, [&]() {
+                return "j[\"" + std::string(key) + "\"] " +
+                       (std::is_enum_v<T> ? "enum" : "value") + " conversion failed: " + what +
+                       " | value: \"" + dumpForLog(*jvalue) + "\"";
+            });
+            return default_value;
+        case ConvertStatus::InvalidType: break;
+    }
+
+    report(key, Issue::Kind::InvalidType, jvalue, policy, [&]() {
+        return "j[\"" + std::string(key) + "\"] has invalid type: \"" + jvalue->type_name() +
+               "\" & value: \"" + dumpForLog(*jvalue) + "\"";
+    });
+    return default_value;
+}
+
+}  // namespace detail
+
+// Key overloads: a single search of the object, and no temporary string for literals or views
+
+template <typename T>
+T getSafe(const json& j, const std::string_view key, const T& default_value) {
+    return detail::getSafe(detail::findMember(j, key), key, default_value, nullptr);
+}
+
+/**
+ * @brief Read a value, reporting failures with policy instead of the global policy
+ */
+template <typename T>
+T getSafe(const json& j,
+          const std::string_view key,
+          const T& default_value,
+          const DiagnosticsPolicy& policy) {
+    return detail::getSafe(detail::findMember(j, key), key, default_value, &policy);
+}
+
+template <typename T>
+T getSafe(const json& j, const char* key, const T& default_value) {
+    return getSafe(j, std::string_view(key), default_value);
+}
+
+template <typename T>
+T getSafe(const json& j, const std::string& key, const T& default_value) {
+    return getSafe(j, std::string_view(key), default_value);
+}
+
+template <typename T>
+T getSafe(const json& j, const std::string_view key) {
+    return getSafe(j, key, T{});
+}
+
+template <typename T>
+T getSafe(const json& j, const char* key) {
+    return getSafe(j, std::string_view(key), T{});
+}
+
+template <typename T>
+T getSafe(const json& j, const std::string& key) {
+    return getSafe(j, std::string_view(key), T{});
+}
+
+/**
+ * @brief Read a nested value, e.g. getSafe(j, Pointer{"/server/ports/0"}, 80)
+ *
+ * The pointer is walked once with a single search per level, without allocating unless a token
+ * contains an escape; warnings name the full pointer. A malformed pointer reads as missing.
+ */
+template <typename T>
+T getSafe(const json& j, const Pointer pointer, const T& default_value) {
+    return detail::getSafe(
+        detail::findPointer(j, pointer.text), pointer.text, default_value, nullptr);
+}
+
+template <typename T>
+T getSafe(const json& j,
+          const Pointer pointer,
+          const T& default_value,
+          const DiagnosticsPolicy& policy) {
+    return detail::getSafe(
+        detail::findPointer(j, pointer.text), pointer.text, default_value, &policy);
+}
+
+template <typename T>
+T getSafe(const json& j, const Pointer pointer) {
+    return getSafe(j, pointer, T{});
+}
+
+/**
+ * @brief Read a nested value, e.g. getSafe(j, "/server/ports/0"_json_pointer, 80)
+ *
+ * json_pointer keeps its tokens apart, so every call joins them back into a string, which
+ * allocates; prefer a constant Pointer on hot paths.
+ */
+template <typename T>
+T getSafe(const json& j, const json::json_pointer& path, const T& default_value) {
+    const std::string pointer = path.to_string();
+    return getSafe(j, Pointer{pointer}, default_value);
+}
+
+template <typename T>
+T getSafe(const json& j,
+          const json::json_pointer& path,
+          const T& default_value,
+          const DiagnosticsPolicy& policy) {
+    const std::string pointer = path.to_string();
+    return getSafe(j, Pointer{pointer}, default_value, policy);
+}
+
+template <typename T>
+T getSafe(const json& j, const json::json_pointer& path) {
+    return getSafe(j, path, T{});
+}
+
+/**
+ * @brief Declarative binding of a JSON object onto the members of a struct
+ *
+ * Fields are declared once with their key, default and optional range; bind() then fills a
+ * struct in a single pass over the object, applying the same conversion rules as getSafe, and
+ * returns every problem in a Report instead of logging.
+ *
+ * @code
+ * static const auto schema = JsonConfig::Schema<ServerConfig>()
+ *                                .field(&ServerConfig::host, "host", "localhost")
+ *                                .field(&ServerConfig::port, "port", 8080, 1, 65535);
+ * ServerConfig config;
+ * const auto report = schema.bind(j, config);
+ * @endcode
+ */
+template <typename Struct>
+class Schema {
+  public:
+    template <typename T>
+    Schema& field(T Struct::*member, std::string key, detail::identity_t<T> default_value) {
+        return addField<T>(member, std::move(key), std::move(default_value), {});
+    }
+
+    /**
+     * @brief Declare a field whose value must lie within [min, max]
+     */
+    template <typename T>
+    Schema& field(T Struct::*member,
+                  std::string key,
+                  detail::identity_t<T> default_value,
+                  detail::identity_t<T> min,
+                  detail::identity_t<T> max) {
+        return addField<T>(member,
+                           std::move(key),
+                           std::move(default_value),
+                           [min = std::move(min), max = std::move(max)](const T& value) {
+                               return !(value < min) && !(max < value);
+                           });
+    }
+
+    /**
+     * @brief Fill every declared field of out from the object j
+     * @param j JSON object; any other type leaves every field at its default
+     * @param out Struct to fill
+     * @return Issues found, empty if every field was present and valid
+     */
+    Report bind(const json& j, Struct& out) const {
+        Report report;
+        std::vector<bool> seen(m_fields.size(), false);
+
+        if (j.is_object()) {
+            for (auto it = j.begin(); it != j.end(); ++it) {
+                const auto found = m_index.find(it.key());
+                if (found == m_index.end()) {
+                    continue;
+                }
+                seen[found->second] = true;
+
+                const Field& field = m_fields[found->second];
+                const json& jvalue = it.value();
+                if (jvalue.is_null()) {
+                    field.reset(out);
+                    report.issues.push_back({field.key, Issue::Kind::Null, {}});
+                    continue;
+                }
+
+                const auto kind = field.assign(jvalue, out);
+                if (kind.has_value()) {
+                    field.reset(out);
+                    report.issues.push_back({field.key, *kind, detail::dumpForLog(jvalue)});
+                }
             }
-            return T{};
         }
-    } else if constexpr (std::is_same_v<T, bool>) {
-        if (jvalue.is_boolean()) {
-            return jvalue.get<T>();
-        }
-    } else if constexpr (std::is_integral_v<T>) {
-        if (jvalue.is_number_integer()) {
-            auto value = jvalue.get<int64_t>();
-            if (value >= static_cast<int64_t>(std::numeric_limits<T>::min()) &&
-                value <= static_cast<int64_t>(std::numeric_limits<T>::max())) {
-                return static_cast<T>(value);
-            } else {
-                return T{};
+
+        for (size_t i = 0; i < m_fields.size(); ++i) {
+            if (!seen[i]) {
+                m_fields[i].reset(out);
+                report.issues.push_back({m_fields[i].key, Issue::Kind::Missing, {}});
             }
         }
-    } else if constexpr (std::is_floating_point_v<T>) {
-        if (jvalue.is_number_float()) {
-            return jvalue.get<T>();
-        }
-    } else if constexpr (std::is_same_v<T, std::string>) {
-        if (jvalue.is_string()) {
-            return jvalue.get<T>();
-        }
+        return report;
     }
 
-    PLOG_WARNING << "j[\"" << key << "\"] has invalid type: \"" << jvalue.type_name()
-                 << "\" & value: \"" << jvalue.dump() << "\"";
-    return T{};
-}
+  private:
+    struct Field {
+        std::string key;
+        // Converts and stores the value, or returns why it could not
+        std::function<std::optional<Issue::Kind>(const json&, Struct&)> assign;
+        std::function<void(Struct&)> reset;
+    };
+
+    std::vector<Field> m_fields;
+    std::unordered_map<std::string, size_t> m_index;
+
+    template <typename T>
+    Schema& addField(T Struct::*member,
+                     std::string key,
+                     T default_value,
+                     std::function<bool(const T&)> in_range) {
+        Field field;
+        field.key = key;
+        field.assign = [member, in_range = std::move(in_range)](
+                           const json& jvalue, Struct& out) -> std::optional<Issue::Kind> {
+            T value{};
+            switch (detail::convert(jvalue, value)) {
+                case detail::ConvertStatus::Ok: break;
+                case detail::ConvertStatus::OutOfRange: return Issue::Kind::OutOfRange;
+                case detail::ConvertStatus::ConversionFailed:
+                    return Issue::Kind::ConversionFailed;
+                case detail::ConvertStatus::InvalidType: return Issue::Kind::InvalidType;
+            }
+            if (in_range && !in_range(value)) {
+                return Issue::Kind::OutOfRange;
+            }
+            out.*member = std::move(value);
+            return std::nullopt;
+        };
+        field.reset = [member, default_value = std::move(default_value)](Struct& out) {
+            out.*member = default_value;
+        };
+
+        // A repeated key replaces the earlier declaration
+        const auto [it, inserted] = m_index.emplace(std::move(key), m_fields.size());
+        if (inserted) {
+            m_fields.push_back(std::move(field));
+        } else {
+            m_fields[it->second] = std::move(field);
+        }
+        return *this;
+    }
+};
 }  // namespace JsonConfig
 
 }  // namespace msh::utils
\ No newline at end of file
@@ -0,0 +1,714 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <plog/Log.h>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__) && !defined(MSH_UTILS_NO_IO_URING) && __has_include(<linux/io_uring.h>)
+#define MSH_UTILS_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+
+#include "byte_array.hpp"
+#include "byte_view.hpp"
+#include "file_io.hpp"
+
+namespace msh::utils {
+
+namespace file_io {
+
+/**
+ * @brief Options for AsyncIO
+ */
+struct AsyncOptions {
+    enum class Backend { Auto, IoUring, ThreadPool };
+
+    /// Auto uses io_uring when the kernel supports it and a thread pool otherwise
+    Backend backend = Backend::Auto;
+    /// Maximum number of files in flight at once with io_uring
+    unsigned queueDepth = 64;
+    /// Worker threads of the thread pool backend, 0 meaning one per hardware thread
+    unsigned threads = 0;
+};
+
+namespace detail {
+
+/**
+ * @brief One asynchronous whole-file read or write
+ */
+struct AsyncRequest {
+    enum class Kind { Read, Write };
+
+    Kind kind = Kind::Read;
+    std::filesystem::path path;
+    ByteArray* output = nullptr;
+    ByteView input;
+    std::function<void(bool)> done;
+
+    // io_uring progress
+    std::string nativePath;
+    int fd = -1;
+    uint64_t offset = 0;
+
+    void finish(const bool ok) {
+        if (done) {
+            done(ok);
+        }
+    }
+};
+
+class AsyncBackend {
+  public:
+    virtual ~AsyncBackend() = default;
+    virtual void submit(std::vector<std::unique_ptr<AsyncRequest>> requests) = 0;
+    virtual void wait() = 0;
+    virtual AsyncOptions::Backend kind() const noexcept = 0;
+};
+
+/**
+ * @brief Runs each request as a blocking read()/write() on a fixed set of worker threads
+ */
+class ThreadPoolBackend final : public AsyncBackend {
+  public:
+    explicit ThreadPoolBackend(unsigned threads) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        m_workers.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) {
+            m_workers.emplace_back([this] { run(); });
+        }
+    }
+
+    ~ThreadPoolBackend() override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    void submit(std::vector<std::unique_ptr<AsyncRequest>> requests) override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& request : requests) {
+                m_queue.push_back(std::move(request));
+                ++m_pending;
+            }
+        }
+        m_wake.notify_all();
+    }
+
+    void wait() override {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this] { return m_pending == 0; });
+    }
+
+    AsyncOptions::Backend kind() const noexcept override {
+        return AsyncOptions::Backend::ThreadPool;
+    }
+
+  private:
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::deque<std::unique_ptr<AsyncRequest>> m_queue;
+    std::vector<std::thread> m_workers;
+    size_t m_pending = 0;
+    bool m_stopping = false;
+
+    void run() {
+        for (;;) {
+            std::unique_ptr<AsyncRequest> request;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+                if (m_queue.empty()) {
+                    return;
+                }
+                request = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+
+            const bool ok = request->kind == AsyncRequest::Kind::Read
+                                ? file_io::read(request->path, *request->output)
+                                : file_io::write(request->path, request->input);
+            request->finish(ok);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_pending == 0) {
+                m_idle.notify_all();
+            }
+        }
+    }
+};
+
+#if defined(MSH_UTILS_HAS_IO_URING)
+/**
+ * @brief Drives open, read/write and close of many files through one io_uring instance
+ *
+ * Callers submit under a mutex; a single reaper thread consumes completions and issues each
+ * request's next step, so at most one operation per request is in the ring at any time. The
+ * reaper only blocks in the kernel while operations are in flight there and otherwise waits on a
+ * condition variable, so submissions the kernel turns away can be retried and shutdown does not
+ * depend on the ring.
+ */
+class UringBackend final : public AsyncBackend {
+  public:
+    explicit UringBackend(const unsigned queue_depth) : m_queueDepth(std::max(1u, queue_depth)) {}
+
+    ~UringBackend() override {
+        if (m_ringFd < 0) {
+            return;
+        }
+        if (m_reaper.joinable()) {
+            wait();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+            }
+            m_wake.notify_all();
+            m_reaper.join();
+        }
+        unmap();
+        ::close(m_ringFd);
+    }
+
+    /**
+     * @brief Create the ring and check that every needed opcode is supported
+     * @return true if io_uring can be used, false otherwise
+     */
+    bool init() {
+        io_uring_params params{};
+        // One slot per in-flight request
+        const auto entries = m_queueDepth;
+        m_ringFd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (m_ringFd < 0) {
+            return false;
+        }
+        if (!map(params) || !probe()) {
+            return false;
+        }
+        m_reaper = std::thread([this] { reap(); });
+        return true;
+    }
+
+    void submit(std::vector<std::unique_ptr<AsyncRequest>> requests) override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& request : requests) {
+                ++m_pending;
+                if (m_inFlight < m_queueDepth) {
+                    ++m_inFlight;
+                    prepareOpen(*request.release());
+                } else {
+                    m_backlog.push_back(std::move(request));
+                }
+            }
+            flush();
+        }
+        m_wake.notify_all();
+    }
+
+    void wait() override {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this] { return m_pending == 0; });
+    }
+
+    AsyncOptions::Backend kind() const noexcept override {
+        return AsyncOptions::Backend::IoUring;
+    }
+
+  private:
+    unsigned m_queueDepth;
+    int m_ringFd = -1;
+
+    void* m_sqRing = nullptr;
+    size_t m_sqRingSize = 0;
+    void* m_cqRing = nullptr;
+    size_t m_cqRingSize = 0;
+    io_uring_sqe* m_sqes = nullptr;
+    size_t m_sqesSize = 0;
+
+    unsigned* m_sqHead = nullptr;
+    unsigned* m_sqTail = nullptr;
+    unsigned* m_sqMask = nullptr;
+    unsigned* m_sqArray = nullptr;
+    unsigned* m_cqHead = nullptr;
+    unsigned* m_cqTail = nullptr;
+    unsigned* m_cqMask = nullptr;
+    io_uring_cqe* m_cqes = nullptr;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::deque<std::unique_ptr<AsyncRequest>> m_backlog;
+    // Requests whose operation could not be submitted, finished with failure by the reaper
+    std::vector<AsyncRequest*> m_failed;
+    std::thread m_reaper;
+    size_t m_pending = 0;
+    unsigned m_inFlight = 0;
+    // Operations taken by the kernel whose completion has not been reaped yet
+    unsigned m_inKernel = 0;
+    bool m_stopping = false;
+
+    // Largest single transfer, io_uring lengths are 32-bit
+    static constexpr uint64_t max_io_size = uint64_t{1} << 30;
+
+    bool map(const io_uring_params& params) {
+        m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+        }
+
+        m_sqRing = ::mmap(nullptr,
+                          m_sqRingSize,
+                          PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE,
+                          m_ringFd,
+                          IORING_OFF_SQ_RING);
+        if (m_sqRing == MAP_FAILED) {
+            m_sqRing = nullptr;
+            return false;
+        }
+        if (single_mmap) {
+            m_cqRing = m_sqRing;
+        } else {
+            m_cqRing = ::mmap(nullptr,
+                              m_cqRingSize,
+                              PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE,
+                              m_ringFd,
+                              IORING_OFF_CQ_RING);
+            if (m_cqRing == MAP_FAILED) {
+                m_cqRing = nullptr;
+                return false;
+            }
+        }
+        m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = ::mmap(nullptr,
+                            m_sqesSize,
+                            PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE,
+                            m_ringFd,
+                            IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            return false;
+        }
+        m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<char*>(m_sqRing);
+        m_sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        m_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        m_sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        auto* cq = static_cast<char*>(m_cqRing);
+        m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        m_cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    void unmap() noexcept {
+        if (m_sqes != nullptr) {
+            ::munmap(m_sqes, m_sqesSize);
+        }
+        if (m_cqRing != nullptr && m_cqRing != m_sqRing) {
+            ::munmap(m_cqRing, m_cqRingSize);
+        }
+        if (m_sqRing != nullptr) {
+            ::munmap(m_sqRing, m_sqRingSize);
+        }
+    }
+
+    bool probe() {
+        constexpr unsigned ops = 256;
+        std::vector<uint8_t> buffer(sizeof(io_uring_probe) + ops * sizeof(io_uring_probe_op));
+        auto* result = reinterpret_cast<io_uring_probe*>(buffer.data());
+        if (::syscall(__NR_io_uring_register, m_ringFd, IORING_REGISTER_PROBE, result, ops) < 0) {
+            return false;
+        }
+        for (const int op : {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_WRITE}) {
+            if (op > result->last_op || (result->ops[op].flags & IO_URING_OP_SUPPORTED) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Must be called with m_mutex held
+    unsigned queued() const noexcept {
+        return *m_sqTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+    }
+
+    /**
+     * Must be called with m_mutex held; hands every queued SQE to the kernel. SQEs it turns away
+     * for lack of resources stay queued for the reaper to retry once completions free some; on
+     * any other error they are taken back and their requests failed.
+     */
+    void flush() {
+        while (queued() > 0) {
+            const int result = enter(queued(), 0, 0);
+            if (result > 0) {
+                m_inKernel += static_cast<unsigned>(result);
+                continue;
+            }
+            if (result < 0 && (errno == EAGAIN || errno == EBUSY || errno == ENOMEM)) {
+                return;
+            }
+
+            PLOG_ERROR << "io_uring submission failed: "
+                       << std::strerror(result < 0 ? errno : EIO);
+            // Nothing else submits, so the unconsumed SQEs can be taken back by rewinding the tail
+            const unsigned head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+            for (unsigned i = head; i != *m_sqTail; ++i) {
+                const io_uring_sqe& sqe = m_sqes[m_sqArray[i & *m_sqMask]];
+                m_failed.push_back(reinterpret_cast<AsyncRequest*>(sqe.user_data));
+            }
+            __atomic_store_n(m_sqTail, head, __ATOMIC_RELEASE);
+            return;
+        }
+    }
+
+    int enter(const unsigned to_submit, const unsigned min_complete, const unsigned flags) {
+        int result;
+        do {
+            result = static_cast<int>(::syscall(
+                __NR_io_uring_enter, m_ringFd, to_submit, min_complete, flags, nullptr, 0));
+        } while (result < 0 && errno == EINTR);
+        return result;
+    }
+
+    // Must be called with m_mutex held; the ring has a free slot for every in-flight request
+    io_uring_sqe* nextSqe() {
+        const unsigned tail = *m_sqTail;
+        const unsigned index = tail & *m_sqMask;
+        io_uring_sqe* sqe = &m_sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        m_sqArray[index] = index;
+        __atomic_store_n(m_sqTail, tail + 1, __ATOMIC_RELEASE);
+        return sqe;
+    }
+
+    void prepareOpen(AsyncRequest& request) {
+        request.nativePath = request.path.string();
+        io_uring_sqe* sqe = nextSqe();
+        sqe->opcode = IORING_OP_OPENAT;
+        sqe->fd = AT_FDCWD;
+        sqe->addr = reinterpret_cast<uint64_t>(request.nativePath.c_str());
+        if (request.kind == AsyncRequest::Kind::Read) {
+            sqe->open_flags = O_RDONLY | O_CLOEXEC;
+        } else {
+            sqe->open_flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+            sqe->len = 0666;
+        }
+        sqe->user_data = reinterpret_cast<uint64_t>(&request);
+    }
+
+    void prepareTransfer(AsyncRequest& request) {
+        io_uring_sqe* sqe = nextSqe();
+        sqe->fd = request.fd;
+        sqe->off = request.offset;
+        if (request.kind == AsyncRequest::Kind::Read) {
+            sqe->opcode = IORING_OP_READ;
+            sqe->addr = reinterpret_cast<uint64_t>(request.output->data() + request.offset);
+            sqe->len = static_cast<uint32_t>(
+                std::min<uint64_t>(request.output->size() - request.offset, max_io_size));
+        } else {
+            sqe->opcode = IORING_OP_WRITE;
+            sqe->addr = reinterpret_cast<uint64_t>(request.input.data() + request.offset);
+            sqe->len = static_cast<uint32_t>(
+                std::min<uint64_t>(request.input.size() - request.offset, max_io_size));
+        }
+        sqe->user_data = reinterpret_cast<uint64_t>(&request);
+    }
+
+    // Advances a request after one of its operations completed; returns true when it is done
+    bool advance(AsyncRequest& request, const int result, bool& ok) {
+        const bool reading = request.kind == AsyncRequest::Kind::Read;
+
+        if (request.fd < 0) {
+            if (result < 0) {
+                PLOG_ERROR << "Failed to open file for " << (reading ? "reading: " : "writing: ")
+                           << request.path;
+                ok = false;
+                return true;
+            }
+            request.fd = result;
+            if (reading) {
+                struct stat st {};
+                if (::fstat(request.fd, &st) != 0) {
+                    PLOG_ERROR << "Failed to read file: " << request.path;
+                    ok = false;
+                    return true;
+                }
+                request.output->resize_for_overwrite(static_cast<ByteArray::size_type>(st.st_size));
+            }
+        } else if (result < 0) {
+            PLOG_ERROR << "Failed to " << (reading ? "read" : "write") << " file: " << request.path;
+            ok = false;
+            return true;
+        } else if (result == 0 && reading) {
+            // The file shrank since it was opened
+            request.output->resize_for_overwrite(static_cast<ByteArray::size_type>(request.offset));
+        } else {
+            request.offset += static_cast<uint64_t>(result);
+        }
+
+        const uint64_t total = reading ? request.output->size() : request.input.size();
+        if (request.offset >= total) {
+            ok = true;
+            return true;
+        }
+        prepareTransfer(request);
+        return false;
+    }
+
+    // Must be called with m_mutex held; closes a finished request and starts a queued one
+    void retire(AsyncRequest* request,
+                const bool ok,
+                std::vector<std::pair<AsyncRequest*, bool>>& finished) {
+        if (request->fd >= 0) {
+            ::close(request->fd);
+            request->fd = -1;
+        }
+        finished.emplace_back(request, ok);
+
+        if (!m_backlog.empty()) {
+            prepareOpen(*m_backlog.front().release());
+            m_backlog.pop_front();
+        } else {
+            --m_inFlight;
+        }
+    }
+
+    void reap() {
+        std::vector<std::pair<AsyncRequest*, bool>> finished;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                // Without operations in the kernel no completion will arrive: retry SQEs it
+                // turned away, or wait for new work, failed submissions or shutdown
+                while (m_inKernel == 0 && m_failed.empty()) {
+                    if (queued() > 0) {
+                        flush();
+                        if (m_inKernel == 0 && m_failed.empty()) {
+                            m_wake.wait_for(lock, std::chrono::milliseconds(1));
+                        }
+                    } else if (m_stopping) {
+                        return;
+                    } else {
+                        m_wake.wait(lock);
+                    }
+                }
+                if (m_inKernel == 0) {
+                    // Only failed submissions to finish
+                    for (AsyncRequest* request : std::exchange(m_failed, {})) {
+                        retire(request, false, finished);
+                    }
+                    flush();
+                }
+            }
+
+            if (finished.empty()) {
+                enter(0, 1, IORING_ENTER_GETEVENTS);
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                unsigned head = *m_cqHead;
+                const unsigned tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+
+                for (; head != tail; ++head) {
+                    const io_uring_cqe& cqe = m_cqes[head & *m_cqMask];
+                    --m_inKernel;
+
+                    auto* request = reinterpret_cast<AsyncRequest*>(cqe.user_data);
+                    bool ok = false;
+                    if (advance(*request, cqe.res, ok)) {
+                        retire(request, ok, finished);
+                    }
+                }
+                __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+                for (AsyncRequest* request : std::exchange(m_failed, {})) {
+                    retire(request, false, finished);
+                }
+                flush();
+            }
+
+            // Callbacks run unlocked so they may queue further requests
+            for (auto& [request, ok] : finished) {
+                request->finish(ok);
+                delete request;
+            }
+            if (!finished.empty()) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_pending -= finished.size();
+                if (m_pending == 0) {
+                    m_idle.notify_all();
+                }
+                finished.clear();
+            }
+        }
+    }
+};
+#endif
+
+}  // namespace detail
+
+/**
+ * @brief Reads and writes many whole files concurrently
+ *
+ * Requests are queued without blocking and complete through a std::future or a callback. On Linux
+ * the work runs through io_uring, so throughput scales with the queue depth rather than with the
+ * number of threads; elsewhere, or when io_uring is unavailable, a thread pool runs the regular
+ * blocking read() and write(). Buffers passed in must stay alive until their request completes.
+ * Callbacks run on an internal thread and should return quickly. The destructor waits for all
+ * outstanding requests.
+ */
+class AsyncIO {
+  public:
+    using Callback = std::function<void(bool)>;
+
+    explicit AsyncIO(const AsyncOptions& options = {}) {
+#if defined(MSH_UTILS_HAS_IO_URING)
+        if (options.backend != AsyncOptions::Backend::ThreadPool) {
+            auto uring = std::make_unique<detail::UringBackend>(options.queueDepth);
+            if (uring->init()) {
+                m_backend = std::move(uring);
+                return;
+            }
+        }
+#endif
+        if (options.backend == AsyncOptions::Backend::IoUring) {
+            PLOG_WARNING << "io_uring is not available, falling back to a thread pool";
+        }
+        m_backend = std::make_unique<detail::ThreadPoolBackend>(options.threads);
+    }
+
+    ~AsyncIO() {
+        wait();
+    }
+
+    AsyncIO(const AsyncIO&) = delete;
+    AsyncIO& operator=(const AsyncIO&) = delete;
+
+    /**
+     * @brief Queue a read of a whole file, like file_io::read
+     * @param path Path to the file to read
+     * @param bytes ByteArray receiving the contents, kept alive by the caller
+     * @return Future set to true if successful, false otherwise
+     */
+    std::future<bool> read(const std::filesystem::path& path, ByteArray& bytes) {
+        auto promise = std::make_shared<std::promise<bool>>();
+        auto future = promise->get_future();
+        read(path, bytes, [promise](const bool ok) { promise->set_value(ok); });
+        return future;
+    }
+
+    void read(const std::filesystem::path& path, ByteArray& bytes, Callback done) {
+        std::vector<std::unique_ptr<detail::AsyncRequest>> requests;
+        requests.push_back(makeRead(path, bytes, std::move(done)));
+        m_backend->submit(std::move(requests));
+    }
+
+    /**
+     * @brief Queue reads of many files in one submission
+     * @param paths Paths to the files to read
+     * @param bytes Resized to paths.size(); receives the contents in the same order
+     * @return One future per file, set to true if successful, false otherwise
+     */
+    std::vector<std::future<bool>> read(const std::vector<std::filesystem::path>& paths,
+                                        std::vector<ByteArray>& bytes) {
+        bytes.resize(paths.size());
+        std::vector<std::future<bool>> futures;
+        std::vector<std::unique_ptr<detail::AsyncRequest>> requests;
+        futures.reserve(paths.size());
+        requests.reserve(paths.size());
+        for (size_t i = 0; i < paths.size(); ++i) {
+            auto promise = std::make_shared<std::promise<bool>>();
+            futures.push_back(promise->get_future());
+            requests.push_back(
+                makeRead(paths[i], bytes[i], [promise](const bool ok) { promise->set_value(ok); }));
+        }
+        m_backend->submit(std::move(requests));
+        return futures;
+    }
+
+    /**
+     * @brief Queue a write of a whole file, like file_io::write
+     * @param path Path to the file to write
+     * @param bytes Bytes to write, kept alive by the caller
+     * @return Future set to true if successful, false otherwise
+     */
+    std::future<bool> write(const std::filesystem::path& path, const ByteView bytes) {
+        auto promise = std::make_shared<std::promise<bool>>();
+        auto future = promise->get_future();
+        write(path, bytes, [promise](const bool ok) { promise->set_value(ok); });
+        return future;
+    }
+
+    void write(const std::filesystem::path& path, const ByteView bytes, Callback done) {
+        auto request = std::make_unique<detail::AsyncRequest>();
+        request->kind = detail::AsyncRequest::Kind::Write;
+        request->path = path;
+        request->input = bytes;
+        request->done = std::move(done);
+
+        std::vector<std::unique_ptr<detail::AsyncRequest>> requests;
+        requests.push_back(std::move(request));
+        m_backend->submit(std::move(requests));
+    }
+
+    /**
+     * @brief Block until every queued request has completed
+     */
+    void wait() {
+        m_backend->wait();
+    }
+
+    /**
+     * @brief Backend actually in use, never Auto
+     */
+    AsyncOptions::Backend backend() const noexcept {
+        return m_backend->kind();
+    }
+
+  private:
+    std::unique_ptr<detail::AsyncBackend> m_backend;
+
+    static std::unique_ptr<detail::AsyncRequest> makeRead(const std::filesystem::path& path,
+                                                          ByteArray& bytes,
+                                                          Callback done) {
+        auto request = std::make_unique<detail::AsyncRequest>();
+        request->kind = detail::AsyncRequest::Kind::Read;
+        request->path = path;
+        request->output = &bytes;
+        request->done = std::move(done);
+        return request;
+    }
+};
+
+}  // namespace file_io
+
+}  // namespace msh::utils
@@ -0,0 +1,149 @@
+#ifndef MSH_UTILS_BASE32_HPP
+#define MSH_UTILS_BASE32_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace msh::utils {
+
+namespace base32 {
+
+namespace detail {
+
+inline constexpr char chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+
+inline constexpr uint8_t invalid_value = 0xFF;
+
+inline constexpr std::array<uint8_t, 256> value_table = [] {
+    std::array<uint8_t, 256> table{};
+    for (auto& entry : table) {
+        entry = invalid_value;
+    }
+    for (int i = 0; i < 32; ++i) {
+        table[static_cast<uint8_t>(chars[i])] = static_cast<uint8_t>(i);
+    }
+    return table;
+}();
+
+// Characters needed for 0..4 trailing bytes, and bytes carried by 0..7 trailing characters
+// (0 marks a length no encoding produces)
+inline constexpr size_t tail_chars[5] = {0, 2, 4, 5, 7};
+inline constexpr size_t tail_bytes[8] = {0, 0, 1, 0, 2, 3, 0, 4};
+
+}  // namespace detail
+
+/**
+ * @brief Number of characters encode() writes for size bytes
+ */
+constexpr size_t encodedSize(const size_t size, const bool padding = true) noexcept {
+    return padding ? (size + 4) / 5 * 8 : size / 5 * 8 + detail::tail_chars[size % 5];
+}
+
+/**
+ * @brief Upper bound of the number of bytes decode() writes for length characters
+ */
+constexpr size_t maxDecodedSize(const size_t length) noexcept {
+    return length / 8 * 5 + detail::tail_bytes[length % 8];
+}
+
+/**
+ * @brief Encode bytes as base32 (RFC 4648)
+ *
+ * Groups of 5 bytes are handled as one 40-bit integer, so the loop has no data-dependent
+ * branches; the codec has no vector kernel, as its 5-bit fields straddle byte boundaries.
+ *
+ * @param src Bytes to encode
+ * @param size Number of bytes to encode
+ * @param dst Output buffer of at least encodedSize(size, padding) characters, not
+ * null-terminated
+ * @param padding Whether to pad the output to a multiple of 8 characters with '='
+ * @return Number of characters written
+ */
+inline size_t encode(const uint8_t* src, const size_t size, char* dst, const bool padding = true) {
+    char* out = dst;
+    size_t i = 0;
+    for (; i + 5 <= size; i += 5) {
+        uint64_t value = 0;
+        for (size_t k = 0; k < 5; ++k) {
+            value = (value << 8) | src[i + k];
+        }
+        for (int shift = 35; shift >= 0; shift -= 5) {
+            *out++ = detail::chars[(value >> shift) & 0x1F];
+        }
+    }
+
+    const size_t rest = size - i;
+    if (rest > 0) {
+        uint64_t value = 0;
+        for (size_t k = 0; k < 5; ++k) {
+            value = (value << 8) | (k < rest ? src[i + k] : 0);
+        }
+        const size_t count = detail::tail_chars[rest];
+        for (size_t k = 0; k < count; ++k) {
+            *out++ = detail::chars[(value >> (35 - 5 * k)) & 0x1F];
+        }
+        if (padding) {
+            for (size_t k = count; k < 8; ++k) {
+                *out++ = '=';
+            }
+        }
+    }
+    return static_cast<size_t>(out - dst);
+}
+
+/**
+ * @brief Decode upper-case base32 (RFC 4648), padded or not
+ *
+ * Decoding is strict: lower case, whitespace, misplaced padding and non-zero bits after the
+ * last byte are rejected.
+ *
+ * @param src Characters to decode
+ * @param length Number of characters
+ * @param dst Output buffer of at least maxDecodedSize(length) bytes
+ * @param size Receives the number of bytes written, only meaningful on success
+ * @return true if successful, false on malformed input
+ */
+inline bool decode(const char* src, const size_t length, uint8_t* dst, size_t& size) {
+    size_t chars = length;
+    if (length % 8 == 0) {
+        while (chars > 0 && length - chars < 6 && src[chars - 1] == '=') {
+            --chars;
+        }
+    }
+    const size_t rest = chars % 8;
+    if (rest != 0 && detail::tail_bytes[rest] == 0) {
+        return false;
+    }
+
+    uint8_t* out = dst;
+    for (size_t i = 0; i < chars; i += 8) {
+        const size_t count = chars - i < 8 ? rest : 8;
+        uint64_t value = 0;
+        uint8_t invalid = 0;
+        for (size_t k = 0; k < 8; ++k) {
+            const uint8_t v = k < count ? detail::value_table[static_cast<uint8_t>(src[i + k])] : 0;
+            invalid |= v;
+            value = (value << 5) | (v & 0x1F);
+        }
+        if (invalid > 0x1F) {
+            return false;
+        }
+
+        const size_t bytes = count == 8 ? 5 : detail::tail_bytes[count];
+        if ((value & ((uint64_t{1} << (40 - 8 * bytes)) - 1)) != 0) {
+            return false;
+        }
+        for (size_t k = 0; k < bytes; ++k) {
+            *out++ = static_cast<uint8_t>(value >> (32 - 8 * k));
+        }
+    }
+    size = static_cast<size_t>(out - dst);
+    return true;
+}
+
+}  // namespace base32
+
+}  // namespace msh::utils
+
+#endif  // MSH_UTILS_BASE32_HPP
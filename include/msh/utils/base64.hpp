@@ -0,0 +1,497 @@
+#ifndef MSH_UTILS_BASE64_HPP
+#define MSH_UTILS_BASE64_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "cpu_features.hpp"
+
+namespace msh::utils {
+
+namespace base64 {
+
+/**
+ * @brief RFC 4648 alphabet: Standard ends in '+' '/', Url in '-' '_'
+ */
+enum class Alphabet { Standard, Url };
+
+namespace detail {
+
+inline constexpr char standard_chars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+inline constexpr char url_chars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+inline constexpr uint8_t invalid_value = 0xFF;
+
+inline constexpr std::array<uint8_t, 256> makeValueTable(const char* chars) {
+    std::array<uint8_t, 256> table{};
+    for (auto& entry : table) {
+        entry = invalid_value;
+    }
+    for (int i = 0; i < 64; ++i) {
+        table[static_cast<uint8_t>(chars[i])] = static_cast<uint8_t>(i);
+    }
+    return table;
+}
+
+inline constexpr std::array<uint8_t, 256> standard_values = makeValueTable(standard_chars);
+inline constexpr std::array<uint8_t, 256> url_values = makeValueTable(url_chars);
+
+inline const char* charsOf(const Alphabet alphabet) noexcept {
+    return alphabet == Alphabet::Standard ? standard_chars : url_chars;
+}
+
+inline const uint8_t* valuesOf(const Alphabet alphabet) noexcept {
+    return alphabet == Alphabet::Standard ? standard_values.data() : url_values.data();
+}
+
+// Encodes whole 3-byte groups
+inline void encodeScalar(const uint8_t* src, const size_t groups, char* dst, const char* chars) {
+    for (size_t i = 0; i < groups; ++i) {
+        const uint32_t value = (static_cast<uint32_t>(src[3 * i]) << 16) |
+                               (static_cast<uint32_t>(src[3 * i + 1]) << 8) | src[3 * i + 2];
+        dst[4 * i] = chars[value >> 18];
+        dst[4 * i + 1] = chars[(value >> 12) & 0x3F];
+        dst[4 * i + 2] = chars[(value >> 6) & 0x3F];
+        dst[4 * i + 3] = chars[value & 0x3F];
+    }
+}
+
+// Returns the number of whole 4-character groups decoded before the first invalid character
+inline size_t decodeScalar(const char* src,
+                           const size_t groups,
+                           uint8_t* dst,
+                           const uint8_t* values) {
+    for (size_t i = 0; i < groups; ++i) {
+        const uint8_t a = values[static_cast<uint8_t>(src[4 * i])];
+        const uint8_t b = values[static_cast<uint8_t>(src[4 * i + 1])];
+        const uint8_t c = values[static_cast<uint8_t>(src[4 * i + 2])];
+        const uint8_t d = values[static_cast<uint8_t>(src[4 * i + 3])];
+        if ((a | b | c | d) > 0x3F) {
+            return i;
+        }
+        const uint32_t value = (static_cast<uint32_t>(a) << 18) | (static_cast<uint32_t>(b) << 12) |
+                               (static_cast<uint32_t>(c) << 6) | d;
+        dst[3 * i] = static_cast<uint8_t>(value >> 16);
+        dst[3 * i + 1] = static_cast<uint8_t>(value >> 8);
+        dst[3 * i + 2] = static_cast<uint8_t>(value);
+    }
+    return groups;
+}
+
+// SIMD kernels process whole blocks only and return the number of 3-byte (encode) or 4-character
+// (decode) groups they handled; the caller finishes the rest with the next narrower kernel.
+//
+// Encoding spreads each 3-byte group over a 32-bit lane and cuts out the four 6-bit indices with
+// two multiplies; the indices are then turned into characters by adding a per-range offset, so
+// only the last two offsets depend on the alphabet. Decoding classifies characters by range,
+// which rejects anything outside the alphabet, and packs the 6-bit values back with two
+// multiply-adds.
+
+#if defined(MSH_UTILS_SSE2)
+MSH_UTILS_TARGET("ssse3")
+inline __m128i indicesToAsciiSsse3(const __m128i indices, const __m128i offsets) {
+    // 0..25 select offset 13, 26..51 offset 0, and 52..63 offsets 1..12
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i is_upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    range = _mm_or_si128(range, _mm_and_si128(is_upper, _mm_set1_epi8(13)));
+    return _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, range));
+}
+
+inline __m128i asciiOffsetsSse2(const char* chars) {
+    return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                         '0' - 52, '0' - 52, '0' - 52, '0' - 52, static_cast<char>(chars[62] - 62),
+                         static_cast<char>(chars[63] - 63), 'A', 0, 0);
+}
+
+MSH_UTILS_TARGET("ssse3")
+inline __m128i splitGroupsSsse3(const __m128i bytes) {
+    // Byte pairs are swapped so each 32-bit lane holds a group as b1 b0 b2 b1
+    const __m128i in = _mm_shuffle_epi8(
+        bytes, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    const __m128i high = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)),
+                                         _mm_set1_epi32(0x04000040));
+    const __m128i low = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)),
+                                        _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(high, low);
+}
+
+MSH_UTILS_TARGET("ssse3")
+inline size_t encodeSsse3(const uint8_t* src, const size_t size, char* dst, const char* chars) {
+    const __m128i offsets = asciiOffsetsSse2(chars);
+
+    // Each step loads 16 bytes but consumes 12
+    size_t i = 0;
+    for (; i + 16 <= size; i += 12) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i / 3 * 4),
+                         indicesToAsciiSsse3(splitGroupsSsse3(bytes), offsets));
+    }
+    return i / 3;
+}
+
+inline __m128i asciiToValuesSse2(const __m128i chars,
+                                 const __m128i char62,
+                                 const __m128i char63,
+                                 __m128i& valid) {
+    const __m128i upper = _mm_sub_epi8(chars, _mm_set1_epi8('A'));
+    const __m128i is_upper = _mm_cmpeq_epi8(_mm_min_epu8(upper, _mm_set1_epi8(25)), upper);
+    const __m128i lower = _mm_sub_epi8(chars, _mm_set1_epi8('a'));
+    const __m128i is_lower = _mm_cmpeq_epi8(_mm_min_epu8(lower, _mm_set1_epi8(25)), lower);
+    const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const __m128i is_62 = _mm_cmpeq_epi8(chars, char62);
+    const __m128i is_63 = _mm_cmpeq_epi8(chars, char63);
+    valid = _mm_and_si128(valid, _mm_or_si128(_mm_or_si128(is_upper, is_lower),
+                                              _mm_or_si128(is_digit, _mm_or_si128(is_62, is_63))));
+    return _mm_or_si128(
+        _mm_or_si128(_mm_and_si128(is_upper, upper),
+                     _mm_and_si128(is_lower, _mm_add_epi8(lower, _mm_set1_epi8(26)))),
+        _mm_or_si128(_mm_and_si128(is_digit, _mm_add_epi8(digit, _mm_set1_epi8(52))),
+                     _mm_or_si128(_mm_and_si128(is_62, _mm_set1_epi8(62)),
+                                  _mm_and_si128(is_63, _mm_set1_epi8(63)))));
+}
+
+// Packs the four 6-bit values of each 32-bit lane into 3 bytes, leaving the 12 results in front
+MSH_UTILS_TARGET("ssse3")
+inline __m128i packValuesSsse3(const __m128i values) {
+    const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    const __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(groups,
+                            _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+MSH_UTILS_TARGET("ssse3")
+inline size_t decodeSsse3(const char* src, const size_t groups, uint8_t* dst, const char* chars) {
+    const __m128i char62 = _mm_set1_epi8(chars[62]);
+    const __m128i char63 = _mm_set1_epi8(chars[63]);
+
+    size_t i = 0;
+    for (; i + 4 <= groups; i += 4) {
+        __m128i valid = _mm_set1_epi8(-1);
+        const __m128i values = asciiToValuesSse2(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i)), char62, char63, valid);
+        if (_mm_movemask_epi8(valid) != 0xFFFF) {
+            break;
+        }
+        // 12 bytes are stored exactly, so the output needs no slack
+        const __m128i packed = packValuesSsse3(values);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 3 * i), packed);
+        const uint32_t last = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(packed, 8)));
+        std::memcpy(dst + 3 * i + 8, &last, sizeof(last));
+    }
+    return i;
+}
+
+MSH_UTILS_TARGET("avx2")
+inline size_t encodeAvx2(const uint8_t* src, const size_t size, char* dst, const char* chars) {
+    const __m256i offsets = _mm256_broadcastsi128_si256(asciiOffsetsSse2(chars));
+    const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1,
+                                             0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+
+    // Each lane takes 12 of 16 loaded bytes, so 28 must be readable for 24 consumed
+    size_t i = 0;
+    for (; i + 28 <= size; i += 24) {
+        const __m256i bytes = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12)), 1);
+        const __m256i in = _mm256_shuffle_epi8(bytes, shuffle);
+        const __m256i high =
+            _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)),
+                               _mm256_set1_epi32(0x04000040));
+        const __m256i low = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)),
+                                               _mm256_set1_epi32(0x01000010));
+        const __m256i indices = _mm256_or_si256(high, low);
+
+        __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        const __m256i is_upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        range = _mm256_or_si256(range, _mm256_and_si256(is_upper, _mm256_set1_epi8(13)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i / 3 * 4),
+                            _mm256_add_epi8(indices, _mm256_shuffle_epi8(offsets, range)));
+    }
+    return i / 3;
+}
+
+MSH_UTILS_TARGET("avx2")
+inline __m256i asciiToValuesAvx2(const __m256i chars,
+                                 const __m256i char62,
+                                 const __m256i char63,
+                                 __m256i& valid) {
+    const __m256i upper = _mm256_sub_epi8(chars, _mm256_set1_epi8('A'));
+    const __m256i is_upper = _mm256_cmpeq_epi8(_mm256_min_epu8(upper, _mm256_set1_epi8(25)), upper);
+    const __m256i lower = _mm256_sub_epi8(chars, _mm256_set1_epi8('a'));
+    const __m256i is_lower = _mm256_cmpeq_epi8(_mm256_min_epu8(lower, _mm256_set1_epi8(25)), lower);
+    const __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    const __m256i is_62 = _mm256_cmpeq_epi8(chars, char62);
+    const __m256i is_63 = _mm256_cmpeq_epi8(chars, char63);
+    valid = _mm256_and_si256(
+        valid, _mm256_or_si256(_mm256_or_si256(is_upper, is_lower),
+                               _mm256_or_si256(is_digit, _mm256_or_si256(is_62, is_63))));
+    return _mm256_or_si256(
+        _mm256_or_si256(_mm256_and_si256(is_upper, upper),
+                        _mm256_and_si256(is_lower, _mm256_add_epi8(lower, _mm256_set1_epi8(26)))),
+        _mm256_or_si256(_mm256_and_si256(is_digit, _mm256_add_epi8(digit, _mm256_set1_epi8(52))),
+                        _mm256_or_si256(_mm256_and_si256(is_62, _mm256_set1_epi8(62)),
+                                        _mm256_and_si256(is_63, _mm256_set1_epi8(63)))));
+}
+
+MSH_UTILS_TARGET("avx2")
+inline size_t decodeAvx2(const char* src, const size_t groups, uint8_t* dst, const char* chars) {
+    const __m256i char62 = _mm256_set1_epi8(chars[62]);
+    const __m256i char63 = _mm256_set1_epi8(chars[63]);
+    const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1,
+                                             -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1,
+                                             -1, -1);
+
+    size_t i = 0;
+    for (; i + 8 <= groups; i += 8) {
+        __m256i valid = _mm256_set1_epi8(-1);
+        const __m256i values = asciiToValuesAvx2(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i)), char62, char63,
+            valid);
+        if (_mm256_movemask_epi8(valid) != -1) {
+            break;
+        }
+        const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        const __m256i packed = _mm256_shuffle_epi8(
+            _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000)), shuffle);
+        // Each lane holds 12 bytes; close the gap between them and store exactly 24
+        const __m256i joined =
+            _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 3 * i),
+                         _mm256_castsi256_si128(joined));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 3 * i + 16),
+                         _mm256_extracti128_si256(joined, 1));
+    }
+    return i;
+}
+#endif
+
+#if defined(MSH_UTILS_NEON)
+inline size_t encodeNeon(const uint8_t* src, const size_t size, char* dst, const char* chars) {
+    uint8x16x4_t table;
+    for (int k = 0; k < 4; ++k) {
+        table.val[k] = vld1q_u8(reinterpret_cast<const uint8_t*>(chars) + 16 * k);
+    }
+    const uint8x16_t mask = vdupq_n_u8(0x3F);
+
+    size_t i = 0;
+    for (; i + 48 <= size; i += 48) {
+        // De-interleaves the first, second and third byte of 16 groups
+        const uint8x16x3_t bytes = vld3q_u8(src + i);
+        uint8x16x4_t indices;
+        indices.val[0] = vshrq_n_u8(bytes.val[0], 2);
+        indices.val[1] =
+            vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[0], 4), vshrq_n_u8(bytes.val[1], 4)), mask);
+        indices.val[2] =
+            vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[1], 2), vshrq_n_u8(bytes.val[2], 6)), mask);
+        indices.val[3] = vandq_u8(bytes.val[2], mask);
+        uint8x16x4_t out;
+        for (int k = 0; k < 4; ++k) {
+            out.val[k] = vqtbl4q_u8(table, indices.val[k]);
+        }
+        vst4q_u8(reinterpret_cast<uint8_t*>(dst + i / 3 * 4), out);
+    }
+    return i / 3;
+}
+
+inline uint8x16_t asciiToValuesNeon(const uint8x16_t chars,
+                                    const uint8x16_t char62,
+                                    const uint8x16_t char63,
+                                    uint8x16_t& valid) {
+    const uint8x16_t upper = vsubq_u8(chars, vdupq_n_u8('A'));
+    const uint8x16_t is_upper = vcleq_u8(upper, vdupq_n_u8(25));
+    const uint8x16_t lower = vsubq_u8(chars, vdupq_n_u8('a'));
+    const uint8x16_t is_lower = vcleq_u8(lower, vdupq_n_u8(25));
+    const uint8x16_t digit = vsubq_u8(chars, vdupq_n_u8('0'));
+    const uint8x16_t is_digit = vcleq_u8(digit, vdupq_n_u8(9));
+    const uint8x16_t is_62 = vceqq_u8(chars, char62);
+    const uint8x16_t is_63 = vceqq_u8(chars, char63);
+    valid = vandq_u8(valid, vorrq_u8(vorrq_u8(is_upper, is_lower),
+                                     vorrq_u8(is_digit, vorrq_u8(is_62, is_63))));
+    return vorrq_u8(vorrq_u8(vandq_u8(is_upper, upper),
+                             vandq_u8(is_lower, vaddq_u8(lower, vdupq_n_u8(26)))),
+                    vorrq_u8(vandq_u8(is_digit, vaddq_u8(digit, vdupq_n_u8(52))),
+                             vorrq_u8(vandq_u8(is_62, vdupq_n_u8(62)),
+                                      vandq_u8(is_63, vdupq_n_u8(63)))));
+}
+
+inline size_t decodeNeon(const char* src, const size_t groups, uint8_t* dst, const char* chars) {
+    const uint8x16_t char62 = vdupq_n_u8(static_cast<uint8_t>(chars[62]));
+    const uint8x16_t char63 = vdupq_n_u8(static_cast<uint8_t>(chars[63]));
+
+    size_t i = 0;
+    for (; i + 16 <= groups; i += 16) {
+        const uint8x16x4_t in = vld4q_u8(reinterpret_cast<const uint8_t*>(src + 4 * i));
+        uint8x16_t valid = vdupq_n_u8(0xFF);
+        uint8x16_t values[4];
+        for (int k = 0; k < 4; ++k) {
+            values[k] = asciiToValuesNeon(in.val[k], char62, char63, valid);
+        }
+        if (vminvq_u8(valid) != 0xFF) {
+            break;
+        }
+        uint8x16x3_t out;
+        out.val[0] = vorrq_u8(vshlq_n_u8(values[0], 2), vshrq_n_u8(values[1], 4));
+        out.val[1] = vorrq_u8(vshlq_n_u8(values[1], 4), vshrq_n_u8(values[2], 2));
+        out.val[2] = vorrq_u8(vshlq_n_u8(values[2], 6), values[3]);
+        vst3q_u8(dst + 3 * i, out);
+    }
+    return i;
+}
+#endif
+
+}  // namespace detail
+
+/**
+ * @brief Number of characters encode() writes for size bytes
+ */
+constexpr size_t encodedSize(const size_t size, const bool padding = true) noexcept {
+    return padding ? (size + 2) / 3 * 4 : size / 3 * 4 + (size % 3 == 0 ? 0 : size % 3 + 1);
+}
+
+/**
+ * @brief Upper bound of the number of bytes decode() writes for length characters
+ */
+constexpr size_t maxDecodedSize(const size_t length) noexcept {
+    return length / 4 * 3 + (length % 4) * 3 / 4;
+}
+
+/**
+ * @brief Encode bytes as base64 (RFC 4648)
+ * @param src Bytes to encode
+ * @param size Number of bytes to encode
+ * @param dst Output buffer of at least encodedSize(size, padding) characters, not
+ * null-terminated
+ * @param alphabet Standard or URL-safe alphabet
+ * @param padding Whether to pad the output to a multiple of 4 characters with '='
+ * @return Number of characters written
+ */
+inline size_t encode(const uint8_t* src,
+                     const size_t size,
+                     char* dst,
+                     const Alphabet alphabet = Alphabet::Standard,
+                     const bool padding = true) {
+    const char* chars = detail::charsOf(alphabet);
+    const size_t groups = size / 3;
+    size_t done = 0;
+#if defined(MSH_UTILS_SSE2)
+    if (cpu::features().avx2) {
+        done = detail::encodeAvx2(src, size, dst, chars);
+    }
+    if (cpu::features().ssse3) {
+        done += detail::encodeSsse3(src + 3 * done, size - 3 * done, dst + 4 * done, chars);
+    }
+#elif defined(MSH_UTILS_NEON)
+    done = detail::encodeNeon(src, size, dst, chars);
+#endif
+    detail::encodeScalar(src + 3 * done, groups - done, dst + 4 * done, chars);
+
+    const uint8_t* tail = src + 3 * groups;
+    char* out = dst + 4 * groups;
+    switch (size % 3) {
+        case 1:
+            *out++ = chars[tail[0] >> 2];
+            *out++ = chars[(tail[0] & 0x03) << 4];
+            if (padding) {
+                *out++ = '=';
+                *out++ = '=';
+            }
+            break;
+        case 2:
+            *out++ = chars[tail[0] >> 2];
+            *out++ = chars[((tail[0] & 0x03) << 4) | (tail[1] >> 4)];
+            *out++ = chars[(tail[1] & 0x0F) << 2];
+            if (padding) {
+                *out++ = '=';
+            }
+            break;
+        default: break;
+    }
+    return static_cast<size_t>(out - dst);
+}
+
+/**
+ * @brief Decode base64 (RFC 4648), padded or not
+ *
+ * Decoding is strict: characters outside the alphabet, including whitespace, misplaced padding
+ * and non-zero bits after the last byte are rejected, so every byte sequence has exactly one
+ * accepted padded and one unpadded encoding.
+ *
+ * @param src Characters to decode
+ * @param length Number of characters
+ * @param dst Output buffer of at least maxDecodedSize(length) bytes
+ * @param size Receives the number of bytes written, only meaningful on success
+ * @param alphabet Standard or URL-safe alphabet
+ * @return true if successful, false on malformed input
+ */
+inline bool decode(const char* src,
+                   const size_t length,
+                   uint8_t* dst,
+                   size_t& size,
+                   const Alphabet alphabet = Alphabet::Standard) {
+    // Padding is only accepted in its full form, leaving a 2 or 3 character tail
+    size_t chars = length;
+    if (length % 4 == 0 && length > 0 && src[length - 1] == '=') {
+        chars -= src[length - 2] == '=' ? 2 : 1;
+    }
+    if (chars % 4 == 1) {
+        return false;
+    }
+
+    const uint8_t* values = detail::valuesOf(alphabet);
+    const size_t groups = chars / 4;
+    size_t done = 0;
+#if defined(MSH_UTILS_SSE2)
+    if (cpu::features().avx2) {
+        done = detail::decodeAvx2(src, groups, dst, detail::charsOf(alphabet));
+    }
+    if (cpu::features().ssse3) {
+        done += detail::decodeSsse3(
+            src + 4 * done, groups - done, dst + 3 * done, detail::charsOf(alphabet));
+    }
+#elif defined(MSH_UTILS_NEON)
+    done = detail::decodeNeon(src, groups, dst, detail::charsOf(alphabet));
+#endif
+    if (detail::decodeScalar(src + 4 * done, groups - done, dst + 3 * done, values) !=
+        groups - done) {
+        return false;
+    }
+
+    const char* tail = src + 4 * groups;
+    uint8_t* out = dst + 3 * groups;
+    if (chars % 4 != 0) {
+        uint32_t value = 0;
+        for (size_t i = 0; i < chars % 4; ++i) {
+            const uint8_t v = values[static_cast<uint8_t>(tail[i])];
+            if (v > 0x3F) {
+                return false;
+            }
+            value = (value << 6) | v;
+        }
+        if (chars % 4 == 2) {
+            if ((value & 0x0F) != 0) {
+                return false;
+            }
+            *out++ = static_cast<uint8_t>(value >> 4);
+        } else {
+            if ((value & 0x03) != 0) {
+                return false;
+            }
+            *out++ = static_cast<uint8_t>(value >> 10);
+            *out++ = static_cast<uint8_t>(value >> 2);
+        }
+    }
+    size = static_cast<size_t>(out - dst);
+    return true;
+}
+
+}  // namespace base64
+
+}  // namespace msh::utils
+
+#endif  // MSH_UTILS_BASE64_HPP
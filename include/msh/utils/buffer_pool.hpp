@@ -0,0 +1,268 @@
+#ifndef MSH_UTILS_BUFFER_POOL_HPP
+#define MSH_UTILS_BUFFER_POOL_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+
+namespace msh::utils {
+
+/**
+ * @brief Process-wide memory resource recycling buffers by power-of-two size class
+ *
+ * Freed blocks go to a small cache of the freeing thread and are handed out again by the next
+ * allocation of the same class on that thread, without locking. Caches that overflow spill half
+ * of their blocks to a shared list per class, from which empty caches refill in batches, so
+ * buffers allocated on one thread and released on another keep circulating. Once the caches are
+ * warm, steady-state allocation does not reach the upstream allocator at all.
+ *
+ * Requests larger than max_block_size, or over-aligned, go straight to the upstream resource.
+ *
+ * @code
+ * ByteArray packet(&BufferPool::instance());
+ * // or route every ByteArray created afterwards through the pool:
+ * std::pmr::set_default_resource(&BufferPool::instance());
+ * @endcode
+ */
+class BufferPool final : public std::pmr::memory_resource {
+  public:
+    static constexpr size_t min_block_size = 64;
+    static constexpr size_t max_block_size = size_t{1} << 20;
+    static constexpr size_t class_count = 15;  // 64 B to 1 MiB
+
+    /// Blocks a thread keeps per class before spilling to the shared list
+    static constexpr size_t local_capacity = 32;
+    /// Blocks the shared list keeps per class before returning them upstream
+    static constexpr size_t shared_capacity = 1024;
+
+    /**
+     * @brief Allocation counters, for tests and metrics
+     */
+    struct Stats {
+        /// Allocations served by a thread cache or the shared lists
+        uint64_t reused = 0;
+        /// Allocations that reached the upstream resource
+        uint64_t upstream = 0;
+    };
+
+    /**
+     * @brief The pool; it is never destroyed, so buffers may be released during static
+     * destruction
+     */
+    static BufferPool& instance() {
+        static BufferPool* pool = new BufferPool();
+        return *pool;
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    Stats stats() const noexcept {
+        return {m_reused.load(std::memory_order_relaxed),
+                m_upstream.load(std::memory_order_relaxed)};
+    }
+
+    /**
+     * @brief Return the blocks cached by the calling thread and the shared lists upstream
+     */
+    void trim() {
+        LocalCache& cache = localCache();
+        for (size_t index = 0; index < class_count; ++index) {
+            freeChain(cache.heads[index], index);
+            cache.heads[index] = nullptr;
+            cache.counts[index] = 0;
+
+            Shared& shared = m_shared[index];
+            Block* chain = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(shared.mutex);
+                chain = shared.head;
+                shared.head = nullptr;
+                shared.count = 0;
+            }
+            freeChain(chain, index);
+        }
+    }
+
+    /**
+     * @brief Usable size of the block serving a request of size bytes
+     */
+    static constexpr size_t blockSize(const size_t size) noexcept {
+        return size > max_block_size ? size : min_block_size << classOf(size);
+    }
+
+  private:
+    struct Block {
+        Block* next;
+    };
+
+    struct Shared {
+        std::mutex mutex;
+        Block* head = nullptr;
+        size_t count = 0;
+    };
+
+    struct LocalCache {
+        std::array<Block*, class_count> heads{};
+        std::array<size_t, class_count> counts{};
+
+        LocalCache() noexcept {
+            localState() = LocalState::Alive;
+        }
+        ~LocalCache();
+    };
+
+    enum class LocalState : uint8_t { Unused, Alive, Destroyed };
+
+    std::array<Shared, class_count> m_shared;
+    std::atomic<uint64_t> m_reused{0};
+    std::atomic<uint64_t> m_upstream{0};
+
+    BufferPool() = default;
+
+    // Trivially destructible, so it can still be read after the thread's cache is destroyed;
+    // frees arriving that late go to the shared lists
+    static LocalState& localState() noexcept {
+        thread_local LocalState state = LocalState::Unused;
+        return state;
+    }
+
+    static LocalCache& localCache() {
+        thread_local LocalCache cache;
+        return cache;
+    }
+
+    static constexpr size_t classOf(const size_t size) noexcept {
+        size_t index = 0;
+        while ((min_block_size << index) < size) {
+            ++index;
+        }
+        return index;
+    }
+
+    static bool pooled(const size_t bytes, const size_t alignment) noexcept {
+        return bytes <= max_block_size && alignment <= alignof(std::max_align_t);
+    }
+
+    void* do_allocate(const size_t bytes, const size_t alignment) override {
+        if (!pooled(bytes, alignment)) {
+            m_upstream.fetch_add(1, std::memory_order_relaxed);
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        const size_t index = classOf(bytes);
+        if (localState() != LocalState::Destroyed) {
+            LocalCache& cache = localCache();
+            if (cache.heads[index] == nullptr) {
+                refill(cache, index);
+            }
+            if (Block* block = cache.heads[index]) {
+                cache.heads[index] = block->next;
+                --cache.counts[index];
+                m_reused.fetch_add(1, std::memory_order_relaxed);
+                return block;
+            }
+        }
+
+        // Always whole blocks, so the block can later be pooled by any thread
+        m_upstream.fetch_add(1, std::memory_order_relaxed);
+        return std::pmr::new_delete_resource()->allocate(min_block_size << index,
+                                                          alignof(std::max_align_t));
+    }
+
+    void do_deallocate(void* pointer, const size_t bytes, const size_t alignment) override {
+        if (!pooled(bytes, alignment)) {
+            std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+            return;
+        }
+
+        const size_t index = classOf(bytes);
+        auto* block = static_cast<Block*>(pointer);
+        if (localState() == LocalState::Destroyed) {
+            block->next = nullptr;
+            spill(block, 1, index);
+            return;
+        }
+
+        LocalCache& cache = localCache();
+        block->next = cache.heads[index];
+        cache.heads[index] = block;
+        if (++cache.counts[index] > local_capacity) {
+            // Hand half of the cache to other threads
+            Block* first = cache.heads[index];
+            Block* last = first;
+            for (size_t i = 1; i < local_capacity / 2; ++i) {
+                last = last->next;
+            }
+            cache.heads[index] = last->next;
+            cache.counts[index] -= local_capacity / 2;
+            last->next = nullptr;
+            spill(first, local_capacity / 2, index);
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    // Moves up to half a cache worth of blocks from the shared list into cache
+    void refill(LocalCache& cache, const size_t index) {
+        Shared& shared = m_shared[index];
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        size_t moved = 0;
+        while (shared.head != nullptr && moved < local_capacity / 2) {
+            Block* block = shared.head;
+            shared.head = block->next;
+            block->next = cache.heads[index];
+            cache.heads[index] = block;
+            ++moved;
+        }
+        shared.count -= moved;
+        cache.counts[index] += moved;
+    }
+
+    // Adds a null-terminated chain of count blocks to the shared list, freeing what exceeds it
+    void spill(Block* chain, const size_t count, const size_t index) {
+        Shared& shared = m_shared[index];
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            if (shared.count + count <= shared_capacity) {
+                Block* last = chain;
+                while (last->next != nullptr) {
+                    last = last->next;
+                }
+                last->next = shared.head;
+                shared.head = chain;
+                shared.count += count;
+                return;
+            }
+        }
+        freeChain(chain, index);
+    }
+
+    static void freeChain(Block* chain, const size_t index) {
+        while (chain != nullptr) {
+            Block* next = chain->next;
+            std::pmr::new_delete_resource()->deallocate(
+                chain, min_block_size << index, alignof(std::max_align_t));
+            chain = next;
+        }
+    }
+};
+
+inline BufferPool::LocalCache::~LocalCache() {
+    localState() = LocalState::Destroyed;
+    BufferPool& pool = instance();
+    for (size_t index = 0; index < class_count; ++index) {
+        if (heads[index] != nullptr) {
+            pool.spill(heads[index], counts[index], index);
+        }
+    }
+}
+
+}  // namespace msh::utils
+
+#endif  // MSH_UTILS_BUFFER_POOL_HPP
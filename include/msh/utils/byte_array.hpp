@@ -3,218 +3,684 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "base32.hpp"
+#include "base64.hpp"
+#include "byte_view.hpp"
+#include "hash.hpp"
+#include "hex.hpp"
+#include "z85.hpp"
+
 namespace msh::utils {
 
+/**
+ * @brief Owning, contiguous byte buffer
+ *
+ * Payloads of up to inline_capacity bytes are stored inside the object itself, so short buffers
+ * such as ids, hashes and keys never touch the heap. Larger payloads move to a heap buffer that
+ * grows geometrically. Any operation that grows the buffer invalidates iterators and views.
+ *
+ * Heap buffers come from a std::pmr::memory_resource, the default resource unless one is passed
+ * in as an allocator_type, e.g. ByteArray packet(&BufferPool::instance()). As with std::pmr
+ * containers, copies use the default resource, moves keep the source's resource and assignment
+ * never changes the resource of the target.
+ */
 class ByteArray {
   public:
     using value_type = uint8_t;
     using size_type = std::size_t;
-    using iterator = typename std::vector<value_type>::iterator;
-    using const_iterator = typename std::vector<value_type>::const_iterator;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+    using allocator_type = std::pmr::polymorphic_allocator<value_type>;
+
+    static constexpr size_type inline_capacity = 32;
 
     // Constructors
     ByteArray() = default;
 
-    explicit ByteArray(const size_type size, const value_type value = 0) : m_data(size, value) {}
+    // Takes an allocator rather than a bare resource pointer so ByteArray(0) stays a size
+    explicit ByteArray(const allocator_type& alloc) noexcept : m_resource(alloc.resource()) {}
+
+    explicit ByteArray(const size_type size, const value_type value = 0) {
+        resize(size, value);
+    }
+
+    ByteArray(const value_type* data, const size_type size) {
+        append(data, size);
+    }
 
-    ByteArray(const value_type* data, const size_type size) : m_data(data, data + size) {}
+    ByteArray(const value_type* data, const size_type size, const allocator_type& alloc)
+        : m_resource(alloc.resource()) {
+        append(data, size);
+    }
+
+    template <typename InputIt,
+              typename = std::enable_if_t<std::is_convertible_v<
+                  typename std::iterator_traits<InputIt>::iterator_category,
+                  std::input_iterator_tag>>>
+    ByteArray(InputIt first, InputIt last) {
+        insert(end(), first, last);
+    }
+
+    ByteArray(const std::initializer_list<value_type> init) {
+        append(init.begin(), init.size());
+    }
 
-    template<typename InputIt>
-    ByteArray(InputIt first, InputIt last) : m_data(first, last) {}
+    explicit ByteArray(const std::string& str) {
+        append(reinterpret_cast<const value_type*>(str.data()), str.size());
+    }
 
-    ByteArray(const std::initializer_list<value_type> init) : m_data(init) {}
+    explicit ByteArray(const ByteView view) {
+        append(view.data(), view.size());
+    }
 
-    explicit ByteArray(const std::string& str)
-        : m_data(reinterpret_cast<const value_type*>(str.data()),
-                 reinterpret_cast<const value_type*>(str.data()) + str.size()) {}
+    ByteArray(const ByteView view, const allocator_type& alloc) : m_resource(alloc.resource()) {
+        append(view.data(), view.size());
+    }
 
     // Copy operations
-    ByteArray(const ByteArray&) = default;
-    ByteArray& operator=(const ByteArray&) = default;
+    ByteArray(const ByteArray& other) {
+        append(other.data(), other.size());
+    }
+
+    ByteArray(const ByteArray& other, const allocator_type& alloc)
+        : m_resource(alloc.resource()) {
+        append(other.data(), other.size());
+    }
+
+    ByteArray& operator=(const ByteArray& other) {
+        if (this != &other) {
+            m_size = 0;
+            append(other.data(), other.size());
+        }
+        return *this;
+    }
 
     // Move operations
-    ByteArray(ByteArray&&) noexcept = default;
-    ByteArray& operator=(ByteArray&&) noexcept = default;
+    ByteArray(ByteArray&& other) noexcept : m_resource(other.m_resource) {
+        steal(other);
+    }
+
+    // Copies instead of stealing when the two resources cannot free each other's memory
+    ByteArray& operator=(ByteArray&& other) {
+        if (this != &other) {
+            if (m_resource == other.m_resource || m_resource->is_equal(*other.m_resource)) {
+                release();
+                steal(other);
+            } else {
+                m_size = 0;
+                append(other.data(), other.size());
+                other.release();
+                other.m_size = 0;
+            }
+        }
+        return *this;
+    }
+
+    ~ByteArray() {
+        release();
+    }
+
+    std::pmr::memory_resource* resource() const noexcept {
+        return m_resource;
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(m_resource);
+    }
 
     // Element access
     value_type& at(const size_type pos) {
-        return m_data.at(pos);
+        if (pos >= m_size) {
+            throw std::out_of_range("ByteArray index out of range");
+        }
+        return data()[pos];
     }
     const value_type& at(const size_type pos) const {
-        return m_data.at(pos);
+        if (pos >= m_size) {
+            throw std::out_of_range("ByteArray index out of range");
+        }
+        return data()[pos];
     }
 
     value_type& operator[](const size_type pos) {
-        return m_data[pos];
+        return data()[pos];
     }
     const value_type& operator[](const size_type pos) const {
-        return m_data[pos];
+        return data()[pos];
     }
 
     value_type& back() {
         if (empty()) {
             throw std::out_of_range("ByteArray is empty");
         }
-        return m_data.back();
+        return data()[m_size - 1];
     }
     const value_type& back() const {
         if (empty()) {
             throw std::out_of_range("ByteArray is empty");
         }
-        return m_data.back();
+        return data()[m_size - 1];
     }
 
     value_type* data() noexcept {
-        return m_data.data();
+        return m_data;
     }
     const value_type* data() const noexcept {
-        return m_data.data();
+        return m_data;
+    }
+
+    ByteView view() const noexcept {
+        return ByteView(data(), m_size);
+    }
+    operator ByteView() const noexcept {
+        return view();
     }
 
     // Iterators
     iterator begin() noexcept {
-        return m_data.begin();
+        return data();
     }
     const_iterator begin() const noexcept {
-        return m_data.begin();
+        return data();
     }
     const_iterator cbegin() const noexcept {
-        return m_data.cbegin();
+        return data();
     }
 
     iterator end() noexcept {
-        return m_data.end();
+        return data() + m_size;
     }
     const_iterator end() const noexcept {
-        return m_data.end();
+        return data() + m_size;
     }
     const_iterator cend() const noexcept {
-        return m_data.cend();
+        return data() + m_size;
     }
 
     // Capacity
     bool empty() const noexcept {
-        return m_data.empty();
+        return m_size == 0;
     }
     size_type size() const noexcept {
-        return m_data.size();
+        return m_size;
     }
     void reserve(const size_type new_cap) {
-        m_data.reserve(new_cap);
+        if (new_cap > m_capacity) {
+            reallocate(new_cap);
+        }
     }
     size_type capacity() const noexcept {
-        return m_data.capacity();
+        return m_capacity;
     }
 
     // Modifiers
     void clear() noexcept {
-        m_data.clear();
+        m_size = 0;
     }
 
     iterator insert(const_iterator pos, const value_type& value) {
-        return m_data.insert(pos, value);
+        return insert(pos, 1, value);
     }
 
     iterator insert(const_iterator pos, value_type&& value) {
-        return m_data.insert(pos, std::move(value));
+        return insert(pos, 1, value);
     }
 
     iterator insert(const_iterator pos, size_type count, const value_type& value) {
-        return m_data.insert(pos, count, value);
+        // Copy first, the value may live inside this buffer
+        const value_type fill = value;
+        value_type* gap = openGap(static_cast<size_type>(pos - cbegin()), count);
+        std::memset(gap, fill, count);
+        return gap;
     }
 
-    template<class InputIt>
+    template <typename InputIt,
+              typename = std::enable_if_t<std::is_convertible_v<
+                  typename std::iterator_traits<InputIt>::iterator_category,
+                  std::input_iterator_tag>>>
     iterator insert(const_iterator pos, InputIt first, InputIt last) {
-        return m_data.insert(pos, first, last);
+        using category = typename std::iterator_traits<InputIt>::iterator_category;
+        const auto index = static_cast<size_type>(pos - cbegin());
+
+        if constexpr (std::is_convertible_v<category, std::forward_iterator_tag>) {
+            const auto count = static_cast<size_type>(std::distance(first, last));
+            value_type* gap = openGap(index, count);
+            std::copy(first, last, gap);
+            return gap;
+        } else {
+            // Single-pass iterators cannot be measured up front, so buffer them first
+            ByteArray buffered;
+            for (; first != last; ++first) {
+                buffered.pushBack(static_cast<value_type>(*first));
+            }
+            value_type* gap = openGap(index, buffered.size());
+            std::memcpy(gap, buffered.data(), buffered.size());
+            return gap;
+        }
     }
 
     iterator insert(const_iterator pos, std::initializer_list<value_type> ilist) {
-        return m_data.insert(pos, ilist);
+        value_type* gap = openGap(static_cast<size_type>(pos - cbegin()), ilist.size());
+        std::memcpy(gap, ilist.begin(), ilist.size());
+        return gap;
     }
 
-    void append(const ByteArray& other) {
-        m_data.insert(m_data.end(), other.begin(), other.end());
+    void append(const ByteView other) {
+        append(other.data(), other.size());
     }
 
     void append(const value_type* data, const size_type size) {
-        m_data.insert(m_data.end(), data, data + size);
+        if (size == 0) {
+            return;
+        }
+        if (m_size + size > m_capacity) {
+            // Keep the old buffer alive until copied, the source may be part of it
+            reallocate(growthFor(m_size + size), data, size);
+        } else {
+            std::memcpy(this->data() + m_size, data, size);
+        }
+        m_size += size;
     }
 
     void resize(size_type count) {
-        m_data.resize(count);
+        resize(count, 0);
     }
+
     void resize(size_type count, value_type value) {
-        m_data.resize(count, value);
+        if (count > m_size) {
+            if (count > m_capacity) {
+                reallocate(growthFor(count));
+            }
+            std::memset(data() + m_size, value, count - m_size);
+        }
+        m_size = count;
+    }
+
+    /**
+     * @brief Resize like resize(), but leave bytes beyond the old size uninitialized
+     * @param count New size; the caller must overwrite the bytes past the old size before reading
+     * them
+     */
+    void resize_for_overwrite(const size_type count) {
+        if (count > m_capacity) {
+            reallocate(growthFor(count));
+        }
+        m_size = count;
+    }
+
+    /**
+     * @brief Let writer fill up to max_n bytes directly after the current end
+     * @param max_n Space made available to writer
+     * @param writer Called as writer(value_type* tail, size_type max_n) and returns the number of
+     * bytes it wrote, at most max_n
+     * @return Number of bytes appended
+     */
+    template <typename Writer>
+    size_type append_with(const size_type max_n, Writer&& writer) {
+        if (m_size + max_n > m_capacity) {
+            reallocate(growthFor(m_size + max_n));
+        }
+        const size_type written =
+            std::min<size_type>(std::forward<Writer>(writer)(data() + m_size, max_n), max_n);
+        m_size += written;
+        return written;
+    }
+
+    // Operations
+    size_type find(const value_type value, const size_type pos = 0) const noexcept {
+        return view().find(value, pos);
+    }
+    size_type find(const ByteView pattern, const size_type pos = 0) const noexcept {
+        return view().find(pattern, pos);
+    }
+
+    size_type rfind(const value_type value, const size_type pos = ByteView::npos) const noexcept {
+        return view().rfind(value, pos);
+    }
+    size_type rfind(const ByteView pattern, const size_type pos = ByteView::npos) const noexcept {
+        return view().rfind(pattern, pos);
+    }
+
+    size_type find_any(const ByteView set, const size_type pos = 0) const noexcept {
+        return view().find_any(set, pos);
+    }
+
+    bool contains(const value_type value) const noexcept {
+        return view().contains(value);
+    }
+    bool contains(const ByteView pattern) const noexcept {
+        return view().contains(pattern);
+    }
+
+    bool starts_with(const ByteView prefix) const noexcept {
+        return view().starts_with(prefix);
+    }
+    bool ends_with(const ByteView suffix) const noexcept {
+        return view().ends_with(suffix);
+    }
+
+    int compare(const ByteView other) const noexcept {
+        return view().compare(other);
+    }
+
+    // Fields view this array and are invalidated when it grows
+    std::vector<ByteView> split(const value_type delimiter) const {
+        return view().split(delimiter);
+    }
+    std::vector<ByteView> split(const ByteView delimiter) const {
+        return view().split(delimiter);
     }
 
     // Comparison operators
     bool operator==(const ByteArray& other) const {
-        return m_data == other.m_data;
+        return view() == other.view();
     }
 
     bool operator!=(const ByteArray& other) const {
         return !(*this == other);
     }
 
+    // Lexicographic by unsigned byte value, so ByteArray can key ordered containers; with
+    // std::less<> lookups by ByteView need no temporary ByteArray
+    bool operator<(const ByteArray& other) const noexcept {
+        return view() < other.view();
+    }
+    bool operator<=(const ByteArray& other) const noexcept {
+        return view() <= other.view();
+    }
+    bool operator>(const ByteArray& other) const noexcept {
+        return view() > other.view();
+    }
+    bool operator>=(const ByteArray& other) const noexcept {
+        return view() >= other.view();
+    }
+
     // Utility functions
-    std::string toHexString() const {
-        static const char hex_chars[] = "0123456789ABCDEF";
-        std::string result;
-        result.reserve(size() * 2);
+    std::string toHexString(const hex::Case letter_case = hex::Case::Upper) const {
+        return view().toHexString(letter_case);
+    }
 
-        for (value_type byte : m_data) {
-            result.push_back(hex_chars[byte >> 4]);
-            result.push_back(hex_chars[byte & 0x0F]);
-        }
+    void toHexString(std::string& out, const hex::Case letter_case = hex::Case::Upper) const {
+        view().toHexString(out, letter_case);
+    }
 
-        return result;
+    std::string toBase64String(const base64::Alphabet alphabet = base64::Alphabet::Standard,
+                               const bool padding = true) const {
+        return view().toBase64String(alphabet, padding);
+    }
+
+    void toBase64String(std::string& out,
+                        const base64::Alphabet alphabet = base64::Alphabet::Standard,
+                        const bool padding = true) const {
+        view().toBase64String(out, alphabet, padding);
+    }
+
+    std::string toBase32String(const bool padding = true) const {
+        return view().toBase32String(padding);
+    }
+
+    void toBase32String(std::string& out, const bool padding = true) const {
+        view().toBase32String(out, padding);
+    }
+
+    std::string toZ85String() const {
+        return view().toZ85String();
+    }
+
+    void toZ85String(std::string& out) const {
+        view().toZ85String(out);
     }
 
     std::string string() const {
-        return std::string(reinterpret_cast<const char*>(m_data.data()), m_data.size());
+        return view().string();
     }
 
-    static ByteArray fromHexString(const std::string& hex) {
+    static ByteArray fromHexString(const std::string_view hex) {
         if (hex.length() % 2 != 0) {
             throw std::invalid_argument("Hex string length must be even");
         }
 
         ByteArray result;
-        result.reserve(hex.length() / 2);
+        if (!decodeHex(hex, result)) {
+            throw std::invalid_argument("Invalid hex character");
+        }
+        return result;
+    }
 
-        for (size_t i = 0; i < hex.length(); i += 2) {
-            char high = std::toupper(hex[i]);
-            char low = std::toupper(hex[i + 1]);
+    // Sets ec to std::errc::invalid_argument and returns an empty array on malformed input
+    static ByteArray fromHexString(const std::string_view hex, std::error_code& ec) {
+        ByteArray result;
+        setDecodeStatus(decodeHex(hex, result), result, ec);
+        return result;
+    }
 
-            if (!std::isxdigit(high) || !std::isxdigit(low)) {
-                throw std::invalid_argument("Invalid hex character");
-            }
+    static std::optional<ByteArray> tryFromHexString(const std::string_view hex) {
+        ByteArray result;
+        if (!decodeHex(hex, result)) {
+            return std::nullopt;
+        }
+        return result;
+    }
 
-            value_type byte = (hexCharToInt(high) << 4) | hexCharToInt(low);
-            result.m_data.push_back(byte);
+    // The base64, base32 and Z85 decoders accept padded and unpadded input but are otherwise
+    // strict; see base64::decode()
+    static ByteArray fromBase64String(
+        const std::string_view text,
+        const base64::Alphabet alphabet = base64::Alphabet::Standard) {
+        ByteArray result;
+        if (!decodeBase64(text, alphabet, result)) {
+            throw std::invalid_argument("Invalid base64 string");
         }
+        return result;
+    }
 
+    static ByteArray fromBase64String(
+        const std::string_view text,
+        std::error_code& ec,
+        const base64::Alphabet alphabet = base64::Alphabet::Standard) {
+        ByteArray result;
+        setDecodeStatus(decodeBase64(text, alphabet, result), result, ec);
+        return result;
+    }
+
+    static std::optional<ByteArray> tryFromBase64String(
+        const std::string_view text,
+        const base64::Alphabet alphabet = base64::Alphabet::Standard) {
+        ByteArray result;
+        if (!decodeBase64(text, alphabet, result)) {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    static ByteArray fromBase32String(const std::string_view text) {
+        ByteArray result;
+        if (!decodeBase32(text, result)) {
+            throw std::invalid_argument("Invalid base32 string");
+        }
+        return result;
+    }
+
+    static ByteArray fromBase32String(const std::string_view text, std::error_code& ec) {
+        ByteArray result;
+        setDecodeStatus(decodeBase32(text, result), result, ec);
+        return result;
+    }
+
+    static std::optional<ByteArray> tryFromBase32String(const std::string_view text) {
+        ByteArray result;
+        if (!decodeBase32(text, result)) {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    static ByteArray fromZ85String(const std::string_view text) {
+        ByteArray result;
+        if (!decodeZ85(text, result)) {
+            throw std::invalid_argument("Invalid Z85 string");
+        }
+        return result;
+    }
+
+    static ByteArray fromZ85String(const std::string_view text, std::error_code& ec) {
+        ByteArray result;
+        setDecodeStatus(decodeZ85(text, result), result, ec);
+        return result;
+    }
+
+    static std::optional<ByteArray> tryFromZ85String(const std::string_view text) {
+        ByteArray result;
+        if (!decodeZ85(text, result)) {
+            return std::nullopt;
+        }
         return result;
     }
 
   private:
-    std::vector<value_type> m_data;
+    value_type* m_data = m_inline;
+    size_type m_size = 0;
+    size_type m_capacity = inline_capacity;
+    value_type m_inline[inline_capacity];
+    std::pmr::memory_resource* m_resource = std::pmr::get_default_resource();
+
+    bool isInline() const noexcept {
+        return m_data == m_inline;
+    }
+
+    size_type growthFor(const size_type required) const noexcept {
+        return std::max(required, m_capacity * 2);
+    }
+
+    void pushBack(const value_type value) {
+        if (m_size == m_capacity) {
+            reallocate(growthFor(m_size + 1));
+        }
+        data()[m_size++] = value;
+    }
+
+    // Moves the contents into a heap buffer of new_cap bytes, optionally appending extra bytes
+    // that are copied before the old buffer is released
+    void reallocate(const size_type new_cap,
+                    const value_type* extra = nullptr,
+                    const size_type extra_size = 0) {
+        auto* buffer = static_cast<value_type*>(m_resource->allocate(new_cap, 1));
+        if (m_size != 0) {
+            std::memcpy(buffer, data(), m_size);
+        }
+        if (extra_size != 0) {
+            std::memcpy(buffer + m_size, extra, extra_size);
+        }
+        release();
+        m_data = buffer;
+        m_capacity = new_cap;
+    }
+
+    // Shifts the tail starting at index right by count bytes and returns the uninitialized gap
+    value_type* openGap(const size_type index, const size_type count) {
+        if (m_size + count > m_capacity) {
+            reallocate(growthFor(m_size + count));
+        }
+        value_type* gap = data() + index;
+        if (count != 0 && index != m_size) {
+            std::memmove(gap + count, gap, m_size - index);
+        }
+        m_size += count;
+        return gap;
+    }
+
+    void release() noexcept {
+        if (!isInline()) {
+            m_resource->deallocate(m_data, m_capacity, 1);
+            m_data = m_inline;
+            m_capacity = inline_capacity;
+        }
+    }
 
-    static value_type hexCharToInt(const char c) {
-        if (c >= '0' && c <= '9')
-            return c - '0';
-        if (c >= 'A' && c <= 'F')
-            return c - 'A' + 10;
-        if (c >= 'a' && c <= 'f')
-            return c - 'a' + 10;
-        throw std::invalid_argument("Invalid hex character");
+    void steal(ByteArray& other) noexcept {
+        if (other.isInline()) {
+            std::memcpy(m_inline, other.m_inline, other.m_size);
+            m_data = m_inline;
+            m_capacity = inline_capacity;
+        } else {
+            m_data = other.m_data;
+            m_capacity = other.m_capacity;
+            other.m_data = other.m_inline;
+            other.m_capacity = inline_capacity;
+        }
+        m_size = other.m_size;
+        other.m_size = 0;
+    }
+
+    static bool decodeHex(const std::string_view hex, ByteArray& out) {
+        if (hex.length() % 2 != 0) {
+            return false;
+        }
+        out.resize_for_overwrite(hex.length() / 2);
+        return hex::decode(hex.data(), hex.length(), out.data());
+    }
+
+    static bool decodeBase64(const std::string_view text,
+                             const base64::Alphabet alphabet,
+                             ByteArray& out) {
+        size_t size = 0;
+        out.resize_for_overwrite(base64::maxDecodedSize(text.length()));
+        if (!base64::decode(text.data(), text.length(), out.data(), size, alphabet)) {
+            return false;
+        }
+        out.resize(size);
+        return true;
+    }
+
+    static bool decodeBase32(const std::string_view text, ByteArray& out) {
+        size_t size = 0;
+        out.resize_for_overwrite(base32::maxDecodedSize(text.length()));
+        if (!base32::decode(text.data(), text.length(), out.data(), size)) {
+            return false;
+        }
+        out.resize(size);
+        return true;
+    }
+
+    static bool decodeZ85(const std::string_view text, ByteArray& out) {
+        out.resize_for_overwrite(z85::decodedSize(text.length()));
+        return z85::decode(text.data(), text.length(), out.data());
+    }
+
+    static void setDecodeStatus(const bool ok, ByteArray& result, std::error_code& ec) {
+        if (ok) {
+            ec.clear();
+        } else {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            result.clear();
+        }
     }
 };
 
 }  // namespace msh::utils
 
-#endif  // MSH_UTILS_BYTE_ARRAY_HPP
\ No newline at end of file
+namespace std {
+
+template <>
+struct hash<msh::utils::ByteArray> {
+    size_t operator()(const msh::utils::ByteArray& bytes) const noexcept {
+        return static_cast<size_t>(msh::utils::hash::hash64(bytes.data(), bytes.size()));
+    }
+};
+
+}  // namespace std
+
+#endif  // MSH_UTILS_BYTE_ARRAY_HPP
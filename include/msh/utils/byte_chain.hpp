@@ -0,0 +1,213 @@
+#ifndef MSH_UTILS_BYTE_CHAIN_HPP
+#define MSH_UTILS_BYTE_CHAIN_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "byte_array.hpp"
+#include "byte_view.hpp"
+#include "shared_bytes.hpp"
+
+namespace msh::utils {
+
+/**
+ * @brief Sequence of byte segments assembled without copying
+ *
+ * A message is built by prepending and appending whole buffers in O(1): owned ByteArrays moved
+ * in, SharedBytes, or borrowed views whose memory the caller keeps alive for the life of the
+ * chain. Nothing is concatenated until flatten() is called; views() exposes the segments for a
+ * vectored write, e.g. file_io::write(path, chain).
+ *
+ * Small copies appended with appendCopy() are gathered into the last owned segment while it has
+ * room or stays below coalesce_limit, so a trailer built from many small fields does not become
+ * many tiny segments, and a large body is never reallocated to grow it.
+ */
+class ByteChain {
+  public:
+    using value_type = uint8_t;
+    using size_type = std::size_t;
+
+    static constexpr size_type coalesce_limit = 4096;
+
+    // Constructors
+    ByteChain() = default;
+
+    explicit ByteChain(ByteArray&& bytes) {
+        append(std::move(bytes));
+    }
+
+    explicit ByteChain(SharedBytes bytes) {
+        append(std::move(bytes));
+    }
+
+    // Capacity
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    /**
+     * @brief Total number of bytes in all segments
+     */
+    size_type size() const noexcept {
+        return m_size;
+    }
+
+    size_type segmentCount() const noexcept {
+        return m_segments.size();
+    }
+
+    // Modifiers
+    void clear() noexcept {
+        m_segments.clear();
+        m_size = 0;
+    }
+
+    /**
+     * @brief Append bytes, taking over their buffer
+     */
+    void append(ByteArray&& bytes) {
+        push(std::move(bytes), false);
+    }
+
+    void append(SharedBytes bytes) {
+        push(std::move(bytes), false);
+    }
+
+    /**
+     * @brief Append a view without copying; its memory must outlive the chain
+     */
+    void appendRef(const ByteView view) {
+        push(view, false);
+    }
+
+    /**
+     * @brief Append a copy of view, into the last segment when it is owned and small or has room
+     */
+    void appendCopy(const ByteView view) {
+        if (view.empty()) {
+            return;
+        }
+        if (!m_segments.empty()) {
+            auto* tail = std::get_if<ByteArray>(&m_segments.back());
+            if (tail != nullptr && (tail->size() + view.size() <= tail->capacity() ||
+                                    tail->size() + view.size() <= coalesce_limit)) {
+                tail->append(view);
+                m_size += view.size();
+                return;
+            }
+        }
+        push(ByteArray(view), false);
+    }
+
+    /**
+     * @brief Move the segments of other to the end of this chain, leaving other empty
+     */
+    void append(ByteChain&& other) {
+        if (m_segments.empty()) {
+            m_segments = std::move(other.m_segments);
+        } else {
+            for (auto& segment : other.m_segments) {
+                m_segments.push_back(std::move(segment));
+            }
+        }
+        m_size += other.m_size;
+        other.clear();
+    }
+
+    void prepend(ByteArray&& bytes) {
+        push(std::move(bytes), true);
+    }
+
+    void prepend(SharedBytes bytes) {
+        push(std::move(bytes), true);
+    }
+
+    /**
+     * @brief Prepend a view without copying; its memory must outlive the chain
+     */
+    void prependRef(const ByteView view) {
+        push(view, true);
+    }
+
+    void prependCopy(const ByteView view) {
+        if (!view.empty()) {
+            push(ByteArray(view), true);
+        }
+    }
+
+    // Operations
+    /**
+     * @brief Views of the segments in order, for a vectored write
+     *
+     * The views are invalidated by any modification of the chain.
+     */
+    std::vector<ByteView> views() const {
+        std::vector<ByteView> result;
+        views(result);
+        return result;
+    }
+
+    // Reuses the capacity of out, which is overwritten
+    void views(std::vector<ByteView>& out) const {
+        out.clear();
+        out.reserve(m_segments.size());
+        for (const auto& segment : m_segments) {
+            out.push_back(viewOf(segment));
+        }
+    }
+
+    /**
+     * @brief Copy all segments into out, which must hold size() bytes
+     */
+    void copyTo(value_type* out) const noexcept {
+        for (const auto& segment : m_segments) {
+            const ByteView view = viewOf(segment);
+            if (!view.empty()) {
+                std::memcpy(out, view.data(), view.size());
+                out += view.size();
+            }
+        }
+    }
+
+    /**
+     * @brief Concatenate the segments into one contiguous buffer
+     */
+    ByteArray flatten() const {
+        ByteArray result;
+        result.resize_for_overwrite(m_size);
+        copyTo(result.data());
+        return result;
+    }
+
+  private:
+    using Segment = std::variant<ByteArray, SharedBytes, ByteView>;
+
+    std::deque<Segment> m_segments;
+    size_type m_size = 0;
+
+    static ByteView viewOf(const Segment& segment) noexcept {
+        return std::visit([](const auto& bytes) { return ByteView(bytes); }, segment);
+    }
+
+    template <typename Bytes>
+    void push(Bytes&& bytes, const bool front) {
+        const size_type size = bytes.size();
+        if (size == 0) {
+            return;
+        }
+        if (front) {
+            m_segments.emplace_front(std::forward<Bytes>(bytes));
+        } else {
+            m_segments.emplace_back(std::forward<Bytes>(bytes));
+        }
+        m_size += size;
+    }
+};
+
+}  // namespace msh::utils
+
+#endif  // MSH_UTILS_BYTE_CHAIN_HPP
@@ -0,0 +1,194 @@
+#ifndef MSH_UTILS_BYTE_READER_HPP
+#define MSH_UTILS_BYTE_READER_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "byte_view.hpp"
+#include "endian.hpp"
+
+namespace msh::utils {
+
+/**
+ * @brief Bounds-checked cursor for decoding binary data
+ *
+ * Reads fixed-width integers, floating point values and enums in little or big endian order,
+ * LEB128 varints, raw bytes and whole arrays, advancing the position past each value. A read
+ * that would pass the end throws std::out_of_range and leaves the position unchanged, so a
+ * decoder can validate a whole message with a single try block instead of checking every field.
+ *
+ * The reader does not own the data, which must outlive it and the views it returns.
+ */
+class ByteReader {
+  public:
+    using size_type = std::size_t;
+
+    // Constructors
+    explicit ByteReader(const ByteView data,
+                        const endian::Order order = endian::Order::Little) noexcept
+        : m_data(data), m_order(order) {}
+
+    // Position
+    size_type position() const noexcept {
+        return m_pos;
+    }
+    size_type size() const noexcept {
+        return m_data.size();
+    }
+    size_type remaining() const noexcept {
+        return m_data.size() - m_pos;
+    }
+    bool atEnd() const noexcept {
+        return m_pos == m_data.size();
+    }
+
+    void seek(const size_type pos) {
+        if (pos > m_data.size()) {
+            throw std::out_of_range("ByteReader position out of range");
+        }
+        m_pos = pos;
+    }
+
+    void skip(const size_type count) {
+        take(count);
+    }
+
+    /**
+     * @brief Byte order used by the reads that do not name one
+     */
+    endian::Order order() const noexcept {
+        return m_order;
+    }
+    void setOrder(const endian::Order order) noexcept {
+        m_order = order;
+    }
+
+    // Reading
+    template <typename T>
+    T read() {
+        return read<T>(m_order);
+    }
+
+    template <typename T>
+    T read(const endian::Order order) {
+        return endian::load<T>(take(sizeof(T)), order);
+    }
+
+    /**
+     * @brief View of the next count bytes, without copying
+     */
+    ByteView readBytes(const size_type count) {
+        return ByteView(take(count), count);
+    }
+
+    void readBytes(uint8_t* out, const size_type count) {
+        const uint8_t* src = take(count);
+        if (count != 0) {
+            std::memcpy(out, src, count);
+        }
+    }
+
+    /**
+     * @brief Read count consecutive values, swapping their byte order in bulk when it differs
+     * from the native one
+     */
+    template <typename T>
+    void readArray(T* out, const size_type count) {
+        readArray(out, count, m_order);
+    }
+
+    template <typename T>
+    void readArray(T* out, const size_type count, const endian::Order order) {
+        static_assert(endian::detail::is_loadable_v<T>,
+                      "T must be an integer, floating point or enum type");
+        if (count > remaining() / sizeof(T)) {
+            throw std::out_of_range("ByteReader read past end");
+        }
+        readBytes(reinterpret_cast<uint8_t*>(out), count * sizeof(T));
+        if (order != endian::native) {
+            endian::swapInPlace(reinterpret_cast<uint8_t*>(out), count, sizeof(T));
+        }
+    }
+
+    /**
+     * @brief Read an unsigned LEB128 varint
+     * @throw std::out_of_range if the data ends inside the varint
+     * @throw std::overflow_error if it does not fit 64 bits
+     */
+    uint64_t readVarint() {
+        uint64_t value = 0;
+        size_type pos = m_pos;
+        for (unsigned shift = 0;; shift += 7) {
+            if (pos == m_data.size()) {
+                throw std::out_of_range("ByteReader read past end");
+            }
+            const uint8_t byte = m_data[pos++];
+            // The tenth byte only has room for the top bit
+            if (shift == 63 && byte > 1) {
+                throw std::overflow_error("Varint exceeds 64 bits");
+            }
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                break;
+            }
+        }
+        m_pos = pos;
+        return value;
+    }
+
+    /**
+     * @brief Read a signed (sign-extended, not zigzag) LEB128 varint
+     * @throw std::out_of_range if the data ends inside the varint
+     * @throw std::overflow_error if it does not fit 64 bits
+     */
+    int64_t readSignedVarint() {
+        uint64_t value = 0;
+        size_type pos = m_pos;
+        unsigned shift = 0;
+        uint8_t byte = 0;
+        do {
+            if (pos == m_data.size()) {
+                throw std::out_of_range("ByteReader read past end");
+            }
+            byte = m_data[pos++];
+            // The tenth byte holds the top bit, and its other bits must repeat it
+            if (shift == 63 && byte != 0x00 && byte != 0x7F) {
+                throw std::overflow_error("Varint exceeds 64 bits");
+            }
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            shift += 7;
+        } while ((byte & 0x80) != 0);
+        if (shift < 64 && (byte & 0x40) != 0) {
+            value |= ~uint64_t{0} << shift;
+        }
+        m_pos = pos;
+        return static_cast<int64_t>(value);
+    }
+
+    /**
+     * @brief View of the bytes not read yet
+     */
+    ByteView unread() const noexcept {
+        return m_data.subview(m_pos);
+    }
+
+  private:
+    ByteView m_data;
+    size_type m_pos = 0;
+    endian::Order m_order;
+
+    // Returns the next count bytes and advances past them
+    const uint8_t* take(const size_type count) {
+        if (count > remaining()) {
+            throw std::out_of_range("ByteReader read past end");
+        }
+        const uint8_t* p = m_data.data() + m_pos;
+        m_pos += count;
+        return p;
+    }
+};
+
+}  // namespace msh::utils
+
+#endif  // MSH_UTILS_BYTE_READER_HPP
@@ -0,0 +1,402 @@
+#ifndef MSH_UTILS_BYTE_SEARCH_HPP
+#define MSH_UTILS_BYTE_SEARCH_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "cpu_features.hpp"
+
+namespace msh::utils {
+
+namespace search {
+
+inline constexpr size_t npos = static_cast<size_t>(-1);
+
+namespace detail {
+
+#if defined(_MSC_VER) && !defined(__clang__)
+inline unsigned lowestBit(const uint32_t mask) noexcept {
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+}
+inline unsigned highestBit(const uint32_t mask) noexcept {
+    unsigned long index = 0;
+    _BitScanReverse(&index, mask);
+    return static_cast<unsigned>(index);
+}
+#else
+inline unsigned lowestBit(const uint32_t mask) noexcept {
+    return static_cast<unsigned>(__builtin_ctz(mask));
+}
+inline unsigned highestBit(const uint32_t mask) noexcept {
+    return static_cast<unsigned>(31 - __builtin_clz(mask));
+}
+#endif
+
+inline size_t rfindScalar(const uint8_t* p, size_t size, const uint8_t value) noexcept {
+    while (size > 0) {
+        if (p[--size] == value) {
+            return size;
+        }
+    }
+    return npos;
+}
+
+// Membership bitmap for sets too large to compare byte by byte
+class ByteSet {
+  public:
+    ByteSet(const uint8_t* set, const size_t size) noexcept {
+        for (size_t i = 0; i < size; ++i) {
+            m_bits[set[i] >> 6] |= uint64_t{1} << (set[i] & 63);
+        }
+    }
+
+    bool contains(const uint8_t value) const noexcept {
+        return ((m_bits[value >> 6] >> (value & 63)) & 1) != 0;
+    }
+
+  private:
+    std::array<uint64_t, 4> m_bits{};
+};
+
+inline size_t findAnyScalar(const uint8_t* p,
+                            const size_t size,
+                            const uint8_t* set,
+                            const size_t set_size) noexcept {
+    const ByteSet members(set, set_size);
+    for (size_t i = 0; i < size; ++i) {
+        if (members.contains(p[i])) {
+            return i;
+        }
+    }
+    return npos;
+}
+
+// Candidate positions are checked with memcmp after the first byte matched
+inline size_t findScalar(const uint8_t* p,
+                         const size_t size,
+                         const uint8_t* pattern,
+                         const size_t pattern_size) noexcept {
+    const size_t last = size - pattern_size;
+    for (size_t i = 0; i <= last;) {
+        const void* found = std::memchr(p + i, pattern[0], last - i + 1);
+        if (found == nullptr) {
+            return npos;
+        }
+        i = static_cast<size_t>(static_cast<const uint8_t*>(found) - p);
+        if (std::memcmp(p + i + 1, pattern + 1, pattern_size - 1) == 0) {
+            return i;
+        }
+        ++i;
+    }
+    return npos;
+}
+
+// SIMD kernels scan whole blocks only. Forward kernels return a match or npos and store in done
+// how many leading bytes they ruled out; rfind kernels shrink size to the bytes left unscanned.
+
+// Sets up to this size are matched with one comparison per member
+inline constexpr size_t max_simd_set = 16;
+
+#if defined(MSH_UTILS_SSE2)
+inline size_t rfindSse2(const uint8_t* p, size_t& size, const uint8_t value) noexcept {
+    const __m128i needle = _mm_set1_epi8(static_cast<char>(value));
+    while (size >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + size - 16));
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+        if (mask != 0) {
+            return size - 16 + highestBit(mask);
+        }
+        size -= 16;
+    }
+    return npos;
+}
+
+inline size_t findAnySse2(const uint8_t* p,
+                          const size_t size,
+                          const uint8_t* set,
+                          const size_t set_size,
+                          size_t& done) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i hits = _mm_setzero_si128();
+        for (size_t s = 0; s < set_size; ++s) {
+            hits = _mm_or_si128(hits,
+                                _mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(set[s]))));
+        }
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        if (mask != 0) {
+            return i + lowestBit(mask);
+        }
+    }
+    done = i;
+    return npos;
+}
+
+// Filters 16 candidate positions at once by their first and last byte
+inline size_t findSse2(const uint8_t* p,
+                       const size_t size,
+                       const uint8_t* pattern,
+                       const size_t pattern_size,
+                       size_t& done) noexcept {
+    const __m128i first = _mm_set1_epi8(static_cast<char>(pattern[0]));
+    const __m128i last = _mm_set1_epi8(static_cast<char>(pattern[pattern_size - 1]));
+    size_t i = 0;
+    for (; i + pattern_size - 1 + 16 <= size; i += 16) {
+        const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const __m128i tail =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + pattern_size - 1));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last))));
+        while (mask != 0) {
+            const size_t candidate = i + lowestBit(mask);
+            if (std::memcmp(p + candidate + 1, pattern + 1, pattern_size - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    done = i;
+    return npos;
+}
+
+MSH_UTILS_TARGET("avx2")
+inline size_t rfindAvx2(const uint8_t* p, size_t& size, const uint8_t value) noexcept {
+    const __m256i needle = _mm256_set1_epi8(static_cast<char>(value));
+    while (size >= 32) {
+        const __m256i block =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + size - 32));
+        const auto mask =
+            static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+        if (mask != 0) {
+            return size - 32 + highestBit(mask);
+        }
+        size -= 32;
+    }
+    return npos;
+}
+
+MSH_UTILS_TARGET("avx2")
+inline size_t findAnyAvx2(const uint8_t* p,
+                          const size_t size,
+                          const uint8_t* set,
+                          const size_t set_size,
+                          size_t& done) noexcept {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        __m256i hits = _mm256_setzero_si256();
+        for (size_t s = 0; s < set_size; ++s) {
+            hits = _mm256_or_si256(
+                hits, _mm256_cmpeq_epi8(block, _mm256_set1_epi8(static_cast<char>(set[s]))));
+        }
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        if (mask != 0) {
+            return i + lowestBit(mask);
+        }
+    }
+    done = i;
+    return npos;
+}
+
+MSH_UTILS_TARGET("avx2")
+inline size_t findAvx2(const uint8_t* p,
+                       const size_t size,
+                       const uint8_t* pattern,
+                       const size_t pattern_size,
+                       size_t& done) noexcept {
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(pattern[0]));
+    const __m256i last = _mm256_set1_epi8(static_cast<char>(pattern[pattern_size - 1]));
+    size_t i = 0;
+    for (; i + pattern_size - 1 + 32 <= size; i += 32) {
+        const __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        const __m256i tail =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + pattern_size - 1));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last))));
+        while (mask != 0) {
+            const size_t candidate = i + lowestBit(mask);
+            if (std::memcmp(p + candidate + 1, pattern + 1, pattern_size - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    done = i;
+    return npos;
+}
+#endif
+
+#if defined(MSH_UTILS_NEON)
+// One bit per lane of a comparison result, via the shift-right-and-narrow idiom
+inline uint64_t maskNeon(const uint8x16_t matches) noexcept {
+    return vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+}
+
+inline size_t rfindNeon(const uint8_t* p, size_t& size, const uint8_t value) noexcept {
+    const uint8x16_t needle = vdupq_n_u8(value);
+    while (size >= 16) {
+        const uint64_t mask = maskNeon(vceqq_u8(vld1q_u8(p + size - 16), needle));
+        if (mask != 0) {
+            return size - 16 + static_cast<size_t>(63 - __builtin_clzll(mask)) / 4;
+        }
+        size -= 16;
+    }
+    return npos;
+}
+
+inline size_t findAnyNeon(const uint8_t* p,
+                          const size_t size,
+                          const uint8_t* set,
+                          const size_t set_size,
+                          size_t& done) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const uint8x16_t block = vld1q_u8(p + i);
+        uint8x16_t hits = vdupq_n_u8(0);
+        for (size_t s = 0; s < set_size; ++s) {
+            hits = vorrq_u8(hits, vceqq_u8(block, vdupq_n_u8(set[s])));
+        }
+        const uint64_t mask = maskNeon(hits);
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctzll(mask)) / 4;
+        }
+    }
+    done = i;
+    return npos;
+}
+#endif
+
+}  // namespace detail
+
+/**
+ * @brief Position of the first occurrence of pattern in [p, p + size), or npos
+ *
+ * An empty pattern is found at position 0.
+ */
+inline size_t find(const uint8_t* p,
+                   const size_t size,
+                   const uint8_t* pattern,
+                   const size_t pattern_size) noexcept {
+    if (pattern_size > size) {
+        return npos;
+    }
+    if (pattern_size == 0) {
+        return 0;
+    }
+    if (pattern_size == 1) {
+        const void* found = std::memchr(p, pattern[0], size);
+        return found != nullptr ? static_cast<size_t>(static_cast<const uint8_t*>(found) - p)
+                                : npos;
+    }
+
+    size_t done = 0;
+#if defined(MSH_UTILS_SSE2)
+    size_t found = npos;
+    if (cpu::features().avx2) {
+        found = detail::findAvx2(p, size, pattern, pattern_size, done);
+    } else {
+        found = detail::findSse2(p, size, pattern, pattern_size, done);
+    }
+    if (found != npos) {
+        return found;
+    }
+#endif
+    const size_t found_tail = detail::findScalar(p + done, size - done, pattern, pattern_size);
+    return found_tail != npos ? done + found_tail : npos;
+}
+
+/**
+ * @brief Position of the last occurrence of value in [p, p + size), or npos
+ */
+inline size_t rfind(const uint8_t* p, size_t size, const uint8_t value) noexcept {
+    size_t found = npos;
+#if defined(MSH_UTILS_SSE2)
+    if (cpu::features().avx2) {
+        found = detail::rfindAvx2(p, size, value);
+    }
+    if (found == npos) {
+        found = detail::rfindSse2(p, size, value);
+    }
+#elif defined(MSH_UTILS_NEON)
+    found = detail::rfindNeon(p, size, value);
+#endif
+    return found != npos ? found : detail::rfindScalar(p, size, value);
+}
+
+/**
+ * @brief Position of the first byte in [p, p + size) that is one of the set_size bytes of set,
+ * or npos
+ */
+inline size_t findAny(const uint8_t* p,
+                      const size_t size,
+                      const uint8_t* set,
+                      const size_t set_size) noexcept {
+    if (set_size == 0) {
+        return npos;
+    }
+    if (set_size == 1) {
+        const void* found = std::memchr(p, set[0], size);
+        return found != nullptr ? static_cast<size_t>(static_cast<const uint8_t*>(found) - p)
+                                : npos;
+    }
+
+    size_t done = 0;
+    if (set_size <= detail::max_simd_set) {
+        size_t found = npos;
+#if defined(MSH_UTILS_SSE2)
+        if (cpu::features().avx2) {
+            found = detail::findAnyAvx2(p, size, set, set_size, done);
+        } else {
+            found = detail::findAnySse2(p, size, set, set_size, done);
+        }
+#elif defined(MSH_UTILS_NEON)
+        found = detail::findAnyNeon(p, size, set, set_size, done);
+#endif
+        if (found != npos) {
+            return found;
+        }
+    }
+    const size_t found_tail = detail::findAnyScalar(p + done, size - done, set, set_size);
+    return found_tail != npos ? done + found_tail : npos;
+}
+
+/**
+ * @brief Compare two equally sized ranges in time independent of their contents
+ *
+ * For secrets such as MACs and tokens, where an early exit would leak how many leading bytes
+ * match.
+ */
+inline bool constantTimeEquals(const uint8_t* a, const uint8_t* b, const size_t size) noexcept {
+    uint64_t difference = 0;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t x;
+        uint64_t y;
+        std::memcpy(&x, a + i, sizeof(x));
+        std::memcpy(&y, b + i, sizeof(y));
+        difference |= x ^ y;
+#if defined(__GNUC__) || defined(__clang__)
+        // Keeps the compiler from turning the accumulation into an early exit
+        __asm__("" : "+r"(difference));
+#endif
+    }
+    for (; i < size; ++i) {
+        difference |= static_cast<uint64_t>(a[i] ^ b[i]);
+#if defined(__GNUC__) || defined(__clang__)
+        __asm__("" : "+r"(difference));
+#endif
+    }
+    return difference == 0;
+}
+
+}  // namespace search
+
+}  // namespace msh::utils
+
+#endif  // MSH_UTILS_BYTE_SEARCH_HPP
@@ -0,0 +1,354 @@
+#ifndef MSH_UTILS_BYTE_VIEW_HPP
+#define MSH_UTILS_BYTE_VIEW_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base32.hpp"
+#include "base64.hpp"
+#include "byte_search.hpp"
+#include "hash.hpp"
+#include "hex.hpp"
+#include "z85.hpp"
+
+namespace msh::utils {
+
+/**
+ * @brief Non-owning, read-only view over a contiguous range of bytes
+ *
+ * The referenced memory must outlive the view. ByteArray converts to ByteView implicitly, so
+ * functions taking a ByteView accept both without copying.
+ */
+class ByteView {
+  public:
+    using value_type = uint8_t;
+    using size_type = std::size_t;
+    using const_iterator = const value_type*;
+    using iterator = const_iterator;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    // Constructors
+    constexpr ByteView() noexcept = default;
+
+    constexpr ByteView(const value_type* data, const size_type size) noexcept
+        : m_data(data), m_size(size) {}
+
+    explicit ByteView(const std::string_view str) noexcept
+        : m_data(reinterpret_cast<const value_type*>(str.data())), m_size(str.size()) {}
+
+    // Element access
+    const value_type& at(const size_type pos) const {
+        if (pos >= m_size) {
+            throw std::out_of_range("ByteView index out of range");
+        }
+        return m_data[pos];
+    }
+
+    constexpr const value_type& operator[](const size_type pos) const noexcept {
+        return m_data[pos];
+    }
+
+    const value_type& front() const {
+        if (empty()) {
+            throw std::out_of_range("ByteView is empty");
+        }
+        return m_data[0];
+    }
+
+    const value_type& back() const {
+        if (empty()) {
+            throw std::out_of_range("ByteView is empty");
+        }
+        return m_data[m_size - 1];
+    }
+
+    constexpr const value_type* data() const noexcept {
+        return m_data;
+    }
+
+    // Iterators
+    constexpr const_iterator begin() const noexcept {
+        return m_data;
+    }
+    constexpr const_iterator cbegin() const noexcept {
+        return m_data;
+    }
+
+    constexpr const_iterator end() const noexcept {
+        return m_data + m_size;
+    }
+    constexpr const_iterator cend() const noexcept {
+        return m_data + m_size;
+    }
+
+    // Capacity
+    constexpr bool empty() const noexcept {
+        return m_size == 0;
+    }
+    constexpr size_type size() const noexcept {
+        return m_size;
+    }
+
+    // Modifiers
+    void remove_prefix(const size_type n) {
+        if (n > m_size) {
+            throw std::out_of_range("ByteView prefix out of range");
+        }
+        m_data += n;
+        m_size -= n;
+    }
+
+    void remove_suffix(const size_type n) {
+        if (n > m_size) {
+            throw std::out_of_range("ByteView suffix out of range");
+        }
+        m_size -= n;
+    }
+
+    // Operations
+    ByteView subview(const size_type pos, const size_type count = npos) const {
+        if (pos > m_size) {
+            throw std::out_of_range("ByteView position out of range");
+        }
+        return ByteView(m_data + pos, std::min(count, m_size - pos));
+    }
+
+    size_type find(const value_type value, const size_type pos = 0) const noexcept {
+        if (pos >= m_size) {
+            return npos;
+        }
+        const void* found = std::memchr(m_data + pos, value, m_size - pos);
+        return found != nullptr ? static_cast<size_type>(static_cast<const value_type*>(found) -
+                                                         m_data)
+                                : npos;
+    }
+
+    size_type find(const ByteView pattern, const size_type pos = 0) const noexcept {
+        if (pos > m_size) {
+            return npos;
+        }
+        const size_type found =
+            search::find(m_data + pos, m_size - pos, pattern.m_data, pattern.m_size);
+        return found != npos ? pos + found : npos;
+    }
+
+    /**
+     * @brief Position of the last occurrence of value at or before pos, or npos
+     */
+    size_type rfind(const value_type value, const size_type pos = npos) const noexcept {
+        const size_type end = pos < m_size ? pos + 1 : m_size;
+        return search::rfind(m_data, end, value);
+    }
+
+    /**
+     * @brief Position of the last occurrence of pattern starting at or before pos, or npos
+     */
+    size_type rfind(const ByteView pattern, const size_type pos = npos) const noexcept {
+        if (pattern.m_size > m_size) {
+            return npos;
+        }
+        size_type start = std::min(pos, m_size - pattern.m_size);
+        if (pattern.empty()) {
+            return start;
+        }
+        for (;;) {
+            start = search::rfind(m_data, start + 1, pattern.m_data[0]);
+            if (start == npos ||
+                std::memcmp(m_data + start + 1, pattern.m_data + 1, pattern.m_size - 1) == 0) {
+                return start;
+            }
+            if (start == 0) {
+                return npos;
+            }
+            --start;
+        }
+    }
+
+    /**
+     * @brief Position of the first byte at or after pos that is one of the bytes of set, or npos
+     *
+     * Sets of up to 16 bytes, typical for delimiters, are matched with SIMD comparisons.
+     */
+    size_type find_any(const ByteView set, const size_type pos = 0) const noexcept {
+        if (pos >= m_size) {
+            return npos;
+        }
+        const size_type found = search::findAny(m_data + pos, m_size - pos, set.m_data, set.m_size);
+        return found != npos ? pos + found : npos;
+    }
+
+    bool contains(const value_type value) const noexcept {
+        return find(value) != npos;
+    }
+    bool contains(const ByteView pattern) const noexcept {
+        return find(pattern) != npos;
+    }
+
+    /**
+     * @brief Fields between occurrences of delimiter, including empty ones
+     *
+     * A view without delimiters yields a single field. The fields view the same memory.
+     */
+    std::vector<ByteView> split(const value_type delimiter) const {
+        std::vector<ByteView> fields;
+        size_type start = 0;
+        for (size_type end = find(delimiter); end != npos; end = find(delimiter, start)) {
+            fields.emplace_back(m_data + start, end - start);
+            start = end + 1;
+        }
+        fields.emplace_back(m_data + start, m_size - start);
+        return fields;
+    }
+
+    /**
+     * @brief Fields between occurrences of a multi-byte delimiter, including empty ones
+     * @throws std::invalid_argument if delimiter is empty
+     */
+    std::vector<ByteView> split(const ByteView delimiter) const {
+        if (delimiter.empty()) {
+            throw std::invalid_argument("ByteView split delimiter is empty");
+        }
+        std::vector<ByteView> fields;
+        size_type start = 0;
+        for (size_type end = find(delimiter); end != npos; end = find(delimiter, start)) {
+            fields.emplace_back(m_data + start, end - start);
+            start = end + delimiter.m_size;
+        }
+        fields.emplace_back(m_data + start, m_size - start);
+        return fields;
+    }
+
+    bool starts_with(const ByteView prefix) const noexcept {
+        return prefix.m_size <= m_size &&
+               (prefix.empty() || std::memcmp(m_data, prefix.m_data, prefix.m_size) == 0);
+    }
+
+    bool ends_with(const ByteView suffix) const noexcept {
+        return suffix.m_size <= m_size &&
+               (suffix.empty() ||
+                std::memcmp(m_data + m_size - suffix.m_size, suffix.m_data, suffix.m_size) == 0);
+    }
+
+    int compare(const ByteView other) const noexcept {
+        const size_type common = std::min(m_size, other.m_size);
+        const int result = common == 0 ? 0 : std::memcmp(m_data, other.m_data, common);
+        if (result != 0) {
+            return result;
+        }
+        return m_size < other.m_size ? -1 : (m_size > other.m_size ? 1 : 0);
+    }
+
+    // Comparison operators
+    friend bool operator==(const ByteView lhs, const ByteView rhs) noexcept {
+        return lhs.m_size == rhs.m_size &&
+               (lhs.m_size == 0 || std::memcmp(lhs.m_data, rhs.m_data, lhs.m_size) == 0);
+    }
+    friend bool operator!=(const ByteView lhs, const ByteView rhs) noexcept {
+        return !(lhs == rhs);
+    }
+    friend bool operator<(const ByteView lhs, const ByteView rhs) noexcept {
+        return lhs.compare(rhs) < 0;
+    }
+    friend bool operator<=(const ByteView lhs, const ByteView rhs) noexcept {
+        return lhs.compare(rhs) <= 0;
+    }
+    friend bool operator>(const ByteView lhs, const ByteView rhs) noexcept {
+        return lhs.compare(rhs) > 0;
+    }
+    friend bool operator>=(const ByteView lhs, const ByteView rhs) noexcept {
+        return lhs.compare(rhs) >= 0;
+    }
+
+    // Utility functions
+    std::string toHexString(const hex::Case letter_case = hex::Case::Upper) const {
+        std::string result;
+        toHexString(result, letter_case);
+        return result;
+    }
+
+    // Reuses the capacity of out, which is overwritten
+    void toHexString(std::string& out, const hex::Case letter_case = hex::Case::Upper) const {
+        out.resize(m_size * 2);
+        hex::encode(m_data, m_size, out.data(), letter_case);
+    }
+
+    std::string toBase64String(const base64::Alphabet alphabet = base64::Alphabet::Standard,
+                               const bool padding = true) const {
+        std::string result;
+        toBase64String(result, alphabet, padding);
+        return result;
+    }
+
+    void toBase64String(std::string& out,
+                        const base64::Alphabet alphabet = base64::Alphabet::Standard,
+                        const bool padding = true) const {
+        out.resize(base64::encodedSize(m_size, padding));
+        base64::encode(m_data, m_size, out.data(), alphabet, padding);
+    }
+
+    std::string toBase32String(const bool padding = true) const {
+        std::string result;
+        toBase32String(result, padding);
+        return result;
+    }
+
+    void toBase32String(std::string& out, const bool padding = true) const {
+        out.resize(base32::encodedSize(m_size, padding));
+        base32::encode(m_data, m_size, out.data(), padding);
+    }
+
+    // Throws std::invalid_argument unless the size is a multiple of 4
+    std::string toZ85String() const {
+        std::string result;
+        toZ85String(result);
+        return result;
+    }
+
+    void toZ85String(std::string& out) const {
+        if (m_size % 4 != 0) {
+            throw std::invalid_argument("Z85 input size must be a multiple of 4");
+        }
+        out.resize(z85::encodedSize(m_size));
+        z85::encode(m_data, m_size, out.data());
+    }
+
+    std::string string() const {
+        return std::string(reinterpret_cast<const char*>(m_data), m_size);
+    }
+
+  private:
+    const value_type* m_data = nullptr;
+    size_type m_size = 0;
+};
+
+/**
+ * @brief Compare two byte sequences in time that depends only on their sizes
+ *
+ * Use for secrets such as MACs and tokens, where an early exit would leak how many leading bytes
+ * match.
+ */
+inline bool constantTimeEquals(const ByteView lhs, const ByteView rhs) noexcept {
+    return lhs.size() == rhs.size() &&
+           search::constantTimeEquals(lhs.data(), rhs.data(), lhs.size());
+}
+
+}  // namespace msh::utils
+
+namespace std {
+
+template <>
+struct hash<msh::utils::ByteView> {
+    size_t operator()(const msh::utils::ByteView& bytes) const noexcept {
+        return static_cast<size_t>(msh::utils::hash::hash64(bytes.data(), bytes.size()));
+    }
+};
+
+}  // namespace std
+
+#endif  // MSH_UTILS_BYTE_VIEW_HPP
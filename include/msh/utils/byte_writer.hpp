@@ -0,0 +1,164 @@
+#ifndef MSH_UTILS_BYTE_WRITER_HPP
+#define MSH_UTILS_BYTE_WRITER_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "byte_array.hpp"
+#include "byte_view.hpp"
+#include "endian.hpp"
+
+namespace msh::utils {
+
+/**
+ * @brief Appends binary encoded values to a ByteArray
+ *
+ * The counterpart of ByteReader: fixed-width integers, floating point values and enums in little
+ * or big endian order, LEB128 varints, raw bytes and whole arrays. Each value is written straight
+ * into the tail of the array, which grows geometrically, so encoding costs no more than a store
+ * per field. Values can be patched in place afterwards, e.g. a length prefix written before its
+ * payload was known.
+ *
+ * The writer references the array, which must outlive it; the array may be used between writes.
+ */
+class ByteWriter {
+  public:
+    using size_type = std::size_t;
+
+    static constexpr size_type max_varint_size = 10;
+
+    // Constructors
+    explicit ByteWriter(ByteArray& out, const endian::Order order = endian::Order::Little) noexcept
+        : m_out(out), m_order(order) {}
+
+    // Capacity
+    /**
+     * @brief Size of the array, including bytes it held before the writer was created
+     */
+    size_type size() const noexcept {
+        return m_out.size();
+    }
+
+    // Makes room for additional bytes to be written without reallocating
+    void reserve(const size_type additional) {
+        m_out.reserve(m_out.size() + additional);
+    }
+
+    ByteArray& buffer() noexcept {
+        return m_out;
+    }
+
+    /**
+     * @brief Byte order used by the writes that do not name one
+     */
+    endian::Order order() const noexcept {
+        return m_order;
+    }
+    void setOrder(const endian::Order order) noexcept {
+        m_order = order;
+    }
+
+    // Writing
+    template <typename T>
+    void write(const T value) {
+        write(value, m_order);
+    }
+
+    template <typename T>
+    void write(const T value, const endian::Order order) {
+        m_out.append_with(sizeof(T), [&](uint8_t* tail, size_type) {
+            endian::store(tail, value, order);
+            return sizeof(T);
+        });
+    }
+
+    void writeBytes(const ByteView bytes) {
+        m_out.append(bytes);
+    }
+
+    /**
+     * @brief Write count consecutive values, swapping their byte order in bulk when it differs
+     * from the native one
+     */
+    template <typename T>
+    void writeArray(const T* values, const size_type count) {
+        writeArray(values, count, m_order);
+    }
+
+    template <typename T>
+    void writeArray(const T* values, const size_type count, const endian::Order order) {
+        static_assert(endian::detail::is_loadable_v<T>,
+                      "T must be an integer, floating point or enum type");
+        if (count == 0) {
+            return;
+        }
+        m_out.append_with(count * sizeof(T), [&](uint8_t* tail, const size_type size) {
+            std::memcpy(tail, values, size);
+            if (order != endian::native) {
+                endian::swapInPlace(tail, count, sizeof(T));
+            }
+            return size;
+        });
+    }
+
+    /**
+     * @brief Write an unsigned LEB128 varint, 1 to 10 bytes
+     */
+    void writeVarint(uint64_t value) {
+        m_out.append_with(max_varint_size, [&](uint8_t* tail, size_type) {
+            size_type n = 0;
+            while (value >= 0x80) {
+                tail[n++] = static_cast<uint8_t>(value | 0x80);
+                value >>= 7;
+            }
+            tail[n++] = static_cast<uint8_t>(value);
+            return n;
+        });
+    }
+
+    /**
+     * @brief Write a signed (sign-extended, not zigzag) LEB128 varint, 1 to 10 bytes
+     */
+    void writeSignedVarint(int64_t value) {
+        m_out.append_with(max_varint_size, [&](uint8_t* tail, size_type) {
+            size_type n = 0;
+            while (true) {
+                const auto byte = static_cast<uint8_t>(value & 0x7F);
+                // Arithmetic shift, keeping the sign
+                value >>= 7;
+                if ((value == 0 && (byte & 0x40) == 0) || (value == -1 && (byte & 0x40) != 0)) {
+                    tail[n++] = byte;
+                    return n;
+                }
+                tail[n++] = static_cast<uint8_t>(byte | 0x80);
+            }
+        });
+    }
+
+    // Patching
+    /**
+     * @brief Overwrite sizeof(T) bytes already written at pos
+     * @throw std::out_of_range if they are not all within the array
+     */
+    template <typename T>
+    void writeAt(const size_type pos, const T value) {
+        writeAt(pos, value, m_order);
+    }
+
+    template <typename T>
+    void writeAt(const size_type pos, const T value, const endian::Order order) {
+        if (pos > m_out.size() || sizeof(T) > m_out.size() - pos) {
+            throw std::out_of_range("ByteWriter position out of range");
+        }
+        endian::store(m_out.data() + pos, value, order);
+    }
+
+  private:
+    ByteArray& m_out;
+    endian::Order m_order;
+};
+
+}  // namespace msh::utils
+
+#endif  // MSH_UTILS_BYTE_WRITER_HPP
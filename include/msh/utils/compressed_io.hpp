@@ -0,0 +1,428 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <plog/Log.h>
+
+// The codecs are optional dependencies, enabled with the ENABLE_ZSTD and ENABLE_LZ4 CMake options
+#if defined(MSH_UTILS_HAS_ZSTD)
+#include <zstd.h>
+#endif
+#if defined(MSH_UTILS_HAS_LZ4)
+#include <lz4frame.h>
+#endif
+
+#include "byte_array.hpp"
+#include "byte_view.hpp"
+#include "file_io.hpp"
+
+namespace msh::utils {
+
+namespace file_io {
+
+enum class Compression { None, Zstd, Lz4 };
+
+/**
+ * @brief Options for writeCompressed()
+ */
+struct CompressOptions {
+    Compression format = Compression::Zstd;
+    /// Codec level, 0 for the codec default; negative levels trade ratio for speed
+    int level = 0;
+    /// zstd worker threads, 0 to compress on the calling thread; ignored for LZ4
+    unsigned threads = 0;
+    /// Atomic replacement and durability of the compressed file
+    WriteOptions write;
+};
+
+namespace detail {
+
+inline constexpr uint8_t zstd_magic[] = {0x28, 0xB5, 0x2F, 0xFD};
+inline constexpr uint8_t lz4_magic[] = {0x04, 0x22, 0x4D, 0x18};
+
+// Compressed bytes handed to the file per write
+inline constexpr size_t compressed_chunk_size = size_t{1} << 20;
+
+// Frame headers are untrusted, so a declared content size is only reserved up front when the
+// file could expand to it at this ratio, which covers any LZ4 frame; larger outputs grow as they
+// are decoded and a forged size fails with the data instead of allocating
+inline constexpr uint64_t max_reserve_ratio = 256;
+
+inline void reserveContent(ByteArray& bytes, const uint64_t content, const uint64_t compressed) {
+    if (content / max_reserve_ratio <= compressed && content <= SIZE_MAX) {
+        bytes.reserve(static_cast<ByteArray::size_type>(content));
+    }
+}
+
+#if defined(MSH_UTILS_HAS_ZSTD)
+struct ZstdDeleter {
+    void operator()(ZSTD_DCtx* context) const noexcept {
+        ZSTD_freeDCtx(context);
+    }
+    void operator()(ZSTD_CCtx* context) const noexcept {
+        ZSTD_freeCCtx(context);
+    }
+};
+
+inline bool decompressZstd(Reader& reader,
+                           ByteArray& bytes,
+                           const uint64_t compressed,
+                           const std::filesystem::path& path) {
+    const std::unique_ptr<ZSTD_DCtx, ZstdDeleter> context(ZSTD_createDCtx());
+    if (!context) {
+        PLOG_ERROR << "Failed to create zstd context: " << path;
+        return false;
+    }
+
+    ByteArray chunk;
+    bool first = true;
+    // 0 once the current frame is complete
+    size_t pending = 0;
+    while (reader.read(chunk)) {
+        if (first) {
+            const auto content = ZSTD_getFrameContentSize(chunk.data(), chunk.size());
+            if (content != ZSTD_CONTENTSIZE_UNKNOWN && content != ZSTD_CONTENTSIZE_ERROR) {
+                reserveContent(bytes, content, compressed);
+            }
+            first = false;
+        }
+
+        ZSTD_inBuffer in{chunk.data(), chunk.size(), 0};
+        // Output that filled the space offered may have more behind it, unless the frame ended
+        bool filled = true;
+        while (in.pos < in.size || (filled && pending != 0)) {
+            const size_t room = std::max(ZSTD_DStreamOutSize(), bytes.capacity() - bytes.size());
+            bytes.append_with(room, [&](uint8_t* tail, const size_t max_n) {
+                ZSTD_outBuffer out{tail, max_n, 0};
+                pending = ZSTD_decompressStream(context.get(), &out, &in);
+                filled = out.pos == max_n;
+                return ZSTD_isError(pending) ? 0 : out.pos;
+            });
+            if (ZSTD_isError(pending)) {
+                PLOG_ERROR << "Corrupt zstd data (" << ZSTD_getErrorName(pending) << "): " << path;
+                return false;
+            }
+        }
+    }
+    if (!reader.eof()) {
+        return false;
+    }
+    if (pending != 0) {
+        PLOG_ERROR << "Truncated zstd data: " << path;
+        return false;
+    }
+    return true;
+}
+
+inline bool compressZstd(File& file, const ByteView bytes, const CompressOptions& options) {
+    const std::unique_ptr<ZSTD_CCtx, ZstdDeleter> context(ZSTD_createCCtx());
+    if (!context) {
+        PLOG_ERROR << "Failed to create zstd context";
+        return false;
+    }
+    ZSTD_CCtx_setParameter(context.get(), ZSTD_c_compressionLevel, options.level);
+    ZSTD_CCtx_setParameter(context.get(), ZSTD_c_checksumFlag, 1);
+    if (options.threads > 0 &&
+        ZSTD_isError(ZSTD_CCtx_setParameter(
+            context.get(), ZSTD_c_nbWorkers, static_cast<int>(options.threads)))) {
+        PLOG_WARNING << "zstd is built without multithreading, compressing on one thread";
+    }
+    // Recorded in the frame header, so the reader can allocate the output once
+    ZSTD_CCtx_setPledgedSrcSize(context.get(), bytes.size());
+
+    ByteArray out;
+    out.resize_for_overwrite(std::min(ZSTD_compressBound(bytes.size()), compressed_chunk_size));
+    ZSTD_inBuffer in{bytes.data(), bytes.size(), 0};
+    size_t remaining = 0;
+    do {
+        ZSTD_outBuffer buffer{out.data(), out.size(), 0};
+        remaining = ZSTD_compressStream2(context.get(), &buffer, &in, ZSTD_e_end);
+        if (ZSTD_isError(remaining)) {
+            PLOG_ERROR << "zstd compression failed: " << ZSTD_getErrorName(remaining);
+            return false;
+        }
+        if (buffer.pos != 0 && !file.writeAll(out.data(), buffer.pos)) {
+            return false;
+        }
+    } while (remaining != 0);
+    return true;
+}
+#endif
+
+#if defined(MSH_UTILS_HAS_LZ4)
+struct Lz4Deleter {
+    void operator()(LZ4F_dctx* context) const noexcept {
+        LZ4F_freeDecompressionContext(context);
+    }
+    void operator()(LZ4F_cctx* context) const noexcept {
+        LZ4F_freeCompressionContext(context);
+    }
+};
+
+// LZ4 frames hold blocks of up to 4 MiB, decoded into at least this much space at a time
+inline constexpr size_t lz4_min_output = size_t{1} << 16;
+
+inline bool decompressLz4(Reader& reader,
+                          ByteArray& bytes,
+                          const uint64_t compressed,
+                          const std::filesystem::path& path) {
+    LZ4F_dctx* raw = nullptr;
+    if (LZ4F_isError(LZ4F_createDecompressionContext(&raw, LZ4F_VERSION))) {
+        PLOG_ERROR << "Failed to create LZ4 context: " << path;
+        return false;
+    }
+    const std::unique_ptr<LZ4F_dctx, Lz4Deleter> context(raw);
+
+    ByteArray chunk;
+    bool first = true;
+    // 0 once the current frame is complete
+    size_t pending = 0;
+    while (reader.read(chunk)) {
+        const uint8_t* src = chunk.data();
+        size_t left = chunk.size();
+        // The content size is only a hint, skipped when the first chunk cuts the header short
+        if (first && left >= LZ4F_HEADER_SIZE_MAX) {
+            LZ4F_frameInfo_t info{};
+            size_t consumed = left;
+            pending = LZ4F_getFrameInfo(context.get(), &info, src, &consumed);
+            if (LZ4F_isError(pending)) {
+                PLOG_ERROR << "Corrupt LZ4 data (" << LZ4F_getErrorName(pending) << "): " << path;
+                return false;
+            }
+            if (info.contentSize != 0) {
+                reserveContent(bytes, info.contentSize, compressed);
+            }
+            src += consumed;
+            left -= consumed;
+        }
+        first = false;
+
+        bool filled = true;
+        while (left != 0 || (filled && pending != 0)) {
+            const size_t room = std::max(lz4_min_output, bytes.capacity() - bytes.size());
+            bytes.append_with(room, [&](uint8_t* tail, const size_t max_n) {
+                size_t produced = max_n;
+                size_t consumed = left;
+                pending = LZ4F_decompress(context.get(), tail, &produced, src, &consumed, nullptr);
+                if (LZ4F_isError(pending)) {
+                    return size_t{0};
+                }
+                src += consumed;
+                left -= consumed;
+                filled = produced == max_n;
+                return produced;
+            });
+            if (LZ4F_isError(pending)) {
+                PLOG_ERROR << "Corrupt LZ4 data (" << LZ4F_getErrorName(pending) << "): " << path;
+                return false;
+            }
+        }
+    }
+    if (!reader.eof()) {
+        return false;
+    }
+    if (pending != 0) {
+        PLOG_ERROR << "Truncated LZ4 data: " << path;
+        return false;
+    }
+    return true;
+}
+
+inline bool compressLz4(File& file, const ByteView bytes, const CompressOptions& options) {
+    LZ4F_cctx* raw = nullptr;
+    if (LZ4F_isError(LZ4F_createCompressionContext(&raw, LZ4F_VERSION))) {
+        PLOG_ERROR << "Failed to create LZ4 context";
+        return false;
+    }
+    const std::unique_ptr<LZ4F_cctx, Lz4Deleter> context(raw);
+
+    LZ4F_preferences_t preferences{};
+    preferences.compressionLevel = options.level;
+    preferences.frameInfo.blockSizeID = LZ4F_max4MB;
+    preferences.frameInfo.contentSize = bytes.size();
+    preferences.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+    // Nothing is held back between updates, which keeps the output bound tight
+    preferences.autoFlush = 1;
+
+    const size_t step = std::min(bytes.size(), compressed_chunk_size);
+    ByteArray out;
+    out.resize_for_overwrite(LZ4F_compressBound(step, &preferences) + LZ4F_HEADER_SIZE_MAX);
+
+    const auto check = [&](const size_t result) {
+        if (LZ4F_isError(result)) {
+            PLOG_ERROR << "LZ4 compression failed: " << LZ4F_getErrorName(result);
+            return false;
+        }
+        return result == 0 || file.writeAll(out.data(), result);
+    };
+
+    if (!check(LZ4F_compressBegin(context.get(), out.data(), out.size(), &preferences))) {
+        return false;
+    }
+    for (size_t pos = 0; pos < bytes.size(); pos += step) {
+        const size_t size = std::min(step, bytes.size() - pos);
+        if (!check(LZ4F_compressUpdate(
+                context.get(), out.data(), out.size(), bytes.data() + pos, size, nullptr))) {
+            return false;
+        }
+    }
+    return check(LZ4F_compressEnd(context.get(), out.data(), out.size(), nullptr));
+}
+#endif
+
+}  // namespace detail
+
+/**
+ * @brief Format of data by its leading magic bytes
+ * @param header The first bytes of a file or buffer; 4 are enough
+ * @return Zstd or Lz4 for a frame of that codec, None otherwise
+ */
+inline Compression detectCompression(const ByteView header) noexcept {
+    if (header.starts_with(ByteView(detail::zstd_magic, sizeof(detail::zstd_magic)))) {
+        return Compression::Zstd;
+    }
+    if (header.starts_with(ByteView(detail::lz4_magic, sizeof(detail::lz4_magic)))) {
+        return Compression::Lz4;
+    }
+    return Compression::None;
+}
+
+/**
+ * @brief Whether this build can read and write format
+ */
+constexpr bool isSupported(const Compression format) noexcept {
+    switch (format) {
+        case Compression::None: return true;
+#if defined(MSH_UTILS_HAS_ZSTD)
+        case Compression::Zstd: return true;
+#endif
+#if defined(MSH_UTILS_HAS_LZ4)
+        case Compression::Lz4: return true;
+#endif
+        default: return false;
+    }
+}
+
+/**
+ * @brief Read a file into a ByteArray, decompressing it if it holds zstd or LZ4 frames
+ *
+ * The format is detected from the magic bytes, and plain files are read as by read(). Compressed
+ * files are streamed StreamOptions::bufferSize bytes at a time and each chunk is decompressed
+ * straight into bytes, so the compressed file is never resident as a whole. bytes is allocated
+ * once when the frame header records a plausible content size, as writeCompressed() does.
+ * Concatenated frames are decoded back to back.
+ *
+ * @param path Path to the file to read
+ * @param bytes Receives the decompressed data
+ * @param options Chunk size and OS hints for reading compressed files
+ * @return true if successful, false on I/O errors, corrupt or truncated data, output that does
+ * not fit in memory, or a codec this build does not support
+ */
+inline bool readDecompressed(const std::filesystem::path& path,
+                             ByteArray& bytes,
+                             const StreamOptions& options = {}) {
+    uint8_t magic[sizeof(detail::zstd_magic)] = {};
+    int64_t length = 0;
+    uint64_t compressed = 0;
+    {
+        detail::File file;
+        if (!file.openRead(path)) {
+            PLOG_ERROR << "Failed to open file for reading: " << path;
+            return false;
+        }
+        length = file.readFull(magic, sizeof(magic));
+        if (length < 0 || !file.size(compressed)) {
+            PLOG_ERROR << "Failed to read file: " << path;
+            return false;
+        }
+    }
+
+    const auto format = detectCompression(ByteView(magic, static_cast<size_t>(length)));
+    if (format == Compression::None) {
+        return read(path, bytes);
+    }
+    if (!isSupported(format)) {
+        PLOG_ERROR << (format == Compression::Zstd ? "zstd" : "LZ4")
+                   << " support is not enabled in this build: " << path;
+        return false;
+    }
+
+    bytes.clear();
+    Reader reader;
+    if (!reader.open(path, options)) {
+        return false;
+    }
+    bool decoded = false;
+    try {
+#if defined(MSH_UTILS_HAS_ZSTD)
+        if (format == Compression::Zstd) {
+            decoded = detail::decompressZstd(reader, bytes, compressed, path);
+        }
+#endif
+#if defined(MSH_UTILS_HAS_LZ4)
+        if (format == Compression::Lz4) {
+            decoded = detail::decompressLz4(reader, bytes, compressed, path);
+        }
+#endif
+    } catch (const std::exception& e) {
+        // A valid frame can still expand beyond what can be allocated
+        PLOG_ERROR << "Failed to decompress file (" << e.what() << "): " << path;
+        decoded = false;
+    }
+    if (!decoded) {
+        bytes.clear();
+    }
+    return decoded;
+}
+
+/**
+ * @brief Compress bytes into a file as one zstd or LZ4 frame
+ *
+ * The frame records the content size and a checksum of the content. Compressed data is written
+ * as it is produced, so it is never held in memory as a whole; with CompressOptions::threads,
+ * zstd compresses on worker threads while the calling thread writes.
+ *
+ * @param path Path to the file to write
+ * @param bytes Data to compress
+ * @param options Format, level, threads, atomic replacement and durability
+ * @return true if successful, false on I/O errors or a codec this build does not support
+ */
+inline bool writeCompressed(const std::filesystem::path& path,
+                            const ByteView bytes,
+                            const CompressOptions& options = {}) {
+    if (options.format == Compression::None) {
+        return write(path, bytes, options.write);
+    }
+    if (!isSupported(options.format)) {
+        PLOG_ERROR << (options.format == Compression::Zstd ? "zstd" : "LZ4")
+                   << " support is not enabled in this build: " << path;
+        return false;
+    }
+
+    detail::File file;
+    const auto destination = options.write.atomic ? detail::atomicDestination(path) : path;
+    const auto target = options.write.atomic ? detail::temporarySibling(destination) : path;
+    if (!file.openWrite(target, options.write.atomic)) {
+        PLOG_ERROR << "Failed to open file for writing: " << path;
+        return false;
+    }
+    bool written = false;
+#if defined(MSH_UTILS_HAS_ZSTD)
+    if (options.format == Compression::Zstd) {
+        written = detail::compressZstd(file, bytes, options);
+    }
+#endif
+#if defined(MSH_UTILS_HAS_LZ4)
+    if (options.format == Compression::Lz4) {
+        written = detail::compressLz4(file, bytes, options);
+    }
+#endif
+    return detail::finishWrite(file, target, destination, written, options.write);
+}
+
+}  // namespace file_io
+
+}  // namespace msh::utils
@@ -0,0 +1,402 @@
+#pragma once
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <nlohmann/json.hpp>
+#include <plog/Log.h>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "JsonConfig.hpp"
+#include "byte_array.hpp"
+#include "byte_view.hpp"
+#include "byte_writer.hpp"
+#include "endian.hpp"
+#include "file_io.hpp"
+#include "hash.hpp"
+
+namespace msh::utils {
+
+namespace JsonConfig {
+
+/**
+ * @brief Options for loadCached()
+ */
+struct CacheOptions {
+    /// Also hash the source and compare it with the cache; slower, but immune to a file being
+    /// replaced with the same size and modification time
+    bool verifyHash = false;
+    /// Durability of cache writes; the cache can always be rebuilt, so none by default
+    file_io::Durability durability = file_io::Durability::None;
+};
+
+namespace detail {
+
+/**
+ * @brief Fixed header at the start of a cache file, followed by the encoded payload
+ *
+ * The cache is only read back on the machine that wrote it, so fields use native byte order.
+ */
+struct CacheHeader {
+    char magic[8];
+    uint32_t format;
+    uint32_t reserved;
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    uint64_t sourceHash;
+    uint64_t payloadSize;
+    uint64_t payloadHash;
+};
+static_assert(sizeof(CacheHeader) == 56, "CacheHeader must not contain padding");
+
+constexpr char cache_magic[8] = {'M', 'S', 'H', 'C', 'F', 'G', '\0', '\0'};
+constexpr uint32_t cache_format = 2;
+
+// Detects a changed source or a damaged cache. hash64 is only stable within a build, but a cache
+// hashed by another build merely fails the check and is rebuilt.
+inline uint64_t cacheHash(const ByteView bytes) noexcept {
+    return hash::hash64(bytes.data(), bytes.size());
+}
+
+// Payload encoding: a tag byte per value, then native-endian fixed-width scalars; strings,
+// arrays and objects carry a 32-bit length. Object members are stored in map order, which lets
+// the decoder append them without searching, the main cost when building a large DOM.
+enum class CacheTag : uint8_t { Null, False, True, Integer, Unsigned, Float, String, Array, Object };
+
+constexpr size_t cache_max_depth = 512;
+
+class CacheEncoder {
+  public:
+    explicit CacheEncoder(ByteArray& out) : m_out(out, endian::native) {}
+
+    bool encode(const json& value) {
+        switch (value.type()) {
+            case json::value_t::null: tag(CacheTag::Null); return true;
+            case json::value_t::boolean:
+                tag(value.get<bool>() ? CacheTag::True : CacheTag::False);
+                return true;
+            case json::value_t::number_integer:
+                tag(CacheTag::Integer);
+                scalar(value.get<int64_t>());
+                return true;
+            case json::value_t::number_unsigned:
+                tag(CacheTag::Unsigned);
+                scalar(value.get<uint64_t>());
+                return true;
+            case json::value_t::number_float:
+                tag(CacheTag::Float);
+                scalar(value.get<double>());
+                return true;
+            case json::value_t::string:
+                tag(CacheTag::String);
+                return string(value.get_ref<const json::string_t&>());
+            case json::value_t::array:
+                tag(CacheTag::Array);
+                if (!length(value.size())) {
+                    return false;
+                }
+                for (const auto& element : value) {
+                    if (!encode(element)) {
+                        return false;
+                    }
+                }
+                return true;
+            case json::value_t::object:
+                tag(CacheTag::Object);
+                if (!length(value.size())) {
+                    return false;
+                }
+                for (const auto& [key, element] : value.get_ref<const json::object_t&>()) {
+                    if (!string(key) || !encode(element)) {
+                        return false;
+                    }
+                }
+                return true;
+            default:
+                // Binary and discarded values never come out of a text config
+                return false;
+        }
+    }
+
+  private:
+    ByteWriter m_out;
+
+    void tag(const CacheTag value) {
+        m_out.write(value);
+    }
+
+    template <typename T>
+    void scalar(const T value) {
+        m_out.write(value);
+    }
+
+    bool length(const size_t value) {
+        if (value > UINT32_MAX) {
+            return false;
+        }
+        scalar(static_cast<uint32_t>(value));
+        return true;
+    }
+
+    bool string(const std::string& value) {
+        if (!length(value.size())) {
+            return false;
+        }
+        m_out.writeBytes(ByteView(reinterpret_cast<const uint8_t*>(value.data()), value.size()));
+        return true;
+    }
+};
+
+class CacheDecoder {
+  public:
+    explicit CacheDecoder(const ByteView in) : m_in(in) {}
+
+    // Decodes exactly one value spanning the whole input
+    bool decodeAll(json& out) {
+        return decode(out, 0) && m_pos == m_in.size();
+    }
+
+  private:
+    ByteView m_in;
+    size_t m_pos = 0;
+
+    bool decode(json& out, const size_t depth) {
+        uint8_t tag = 0;
+        if (depth > cache_max_depth || !scalar(tag)) {
+            return false;
+        }
+
+        switch (static_cast<CacheTag>(tag)) {
+            case CacheTag::Null: out = nullptr; return true;
+            case CacheTag::False: out = false; return true;
+            case CacheTag::True: out = true; return true;
+            case CacheTag::Integer: return number<int64_t>(out);
+            case CacheTag::Unsigned: return number<uint64_t>(out);
+            case CacheTag::Float: return number<double>(out);
+            case CacheTag::String: {
+                out = json::string_t();
+                return string(out.get_ref<json::string_t&>());
+            }
+            case CacheTag::Array: {
+                uint32_t count = 0;
+                if (!scalar(count) || count > m_in.size() - m_pos) {
+                    return false;
+                }
+                out = json::array();
+                auto& array = out.get_ref<json::array_t&>();
+                array.resize(count);
+                for (auto& element : array) {
+                    if (!decode(element, depth + 1)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            case CacheTag::Object: {
+                uint32_t count = 0;
+                if (!scalar(count) || count > m_in.size() - m_pos) {
+                    return false;
+                }
+                out = json::object();
+                auto& object = out.get_ref<json::object_t&>();
+                std::string key;
+                for (uint32_t i = 0; i < count; ++i) {
+                    if (!string(key)) {
+                        return false;
+                    }
+                    // Keys arrive in map order, so the end is always the right insertion point
+                    const auto it = object.emplace_hint(object.end(), std::move(key), nullptr);
+                    if (!decode(it->second, depth + 1)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename T>
+    bool scalar(T& value) {
+        if (sizeof(T) > m_in.size() - m_pos) {
+            return false;
+        }
+        std::memcpy(&value, m_in.data() + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    bool number(json& out) {
+        T value{};
+        if (!scalar(value)) {
+            return false;
+        }
+        out = value;
+        return true;
+    }
+
+    bool string(std::string& out) {
+        uint32_t size = 0;
+        if (!scalar(size) || size > m_in.size() - m_pos) {
+            return false;
+        }
+        out.assign(reinterpret_cast<const char*>(m_in.data() + m_pos), size);
+        m_pos += size;
+        return true;
+    }
+};
+
+struct SourceStamp {
+    uint64_t size = 0;
+    int64_t time = 0;
+};
+
+inline bool stampOf(const std::filesystem::path& source, SourceStamp& stamp) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(source, ec);
+    if (ec) {
+        return false;
+    }
+    const auto time = std::filesystem::last_write_time(source, ec);
+    if (ec) {
+        return false;
+    }
+    stamp.size = size;
+    stamp.time = static_cast<int64_t>(time.time_since_epoch().count());
+    return true;
+}
+
+inline bool writeCache(const std::filesystem::path& cache,
+                       const json& config,
+                       const SourceStamp& stamp,
+                       const uint64_t source_hash,
+                       const file_io::Durability durability) {
+    ByteArray payload;
+    if (!CacheEncoder(payload).encode(config)) {
+        PLOG_ERROR << "Config cannot be cached: " << cache;
+        return false;
+    }
+
+    CacheHeader header{};
+    std::memcpy(header.magic, cache_magic, sizeof(header.magic));
+    header.format = cache_format;
+    header.sourceSize = stamp.size;
+    header.sourceTime = stamp.time;
+    header.sourceHash = source_hash;
+    header.payloadSize = payload.size();
+    header.payloadHash = cacheHash(payload);
+
+    file_io::WriteOptions options;
+    options.atomic = true;
+    options.durability = durability;
+    return file_io::write(
+        cache,
+        {ByteView(reinterpret_cast<const uint8_t*>(&header), sizeof(header)),
+         payload},
+        options);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Save config as the binary cache of source
+ *
+ * The cache is keyed by the current size, modification time and hash of source, so source must
+ * be the file config was parsed from.
+ *
+ * @param source Text config the cache stands for
+ * @param cache Path of the cache file, replaced atomically
+ * @param config Parsed, and typically validated, content of source
+ * @return true if successful, false otherwise
+ */
+inline bool writeCache(const std::filesystem::path& source,
+                       const std::filesystem::path& cache,
+                       const json& config,
+                       const CacheOptions& options = {}) {
+    detail::SourceStamp stamp;
+    ByteArray bytes;
+    if (!detail::stampOf(source, stamp) || !file_io::read(source, bytes)) {
+        PLOG_ERROR << "Failed to read config source: " << source;
+        return false;
+    }
+    return detail::writeCache(cache, config, stamp, detail::cacheHash(bytes), options.durability);
+}
+
+/**
+ * @brief Load a JSON config, using a binary cache to skip text parsing when source is unchanged
+ *
+ * The cache is used when it was written for the same source size and modification time (and
+ * hash, with verifyHash). Otherwise source is parsed and the cache rewritten; failing to write
+ * the cache is logged but does not fail the load.
+ *
+ * @param source Text config file
+ * @param cache Path of the cache file, created when missing or stale
+ * @param config Receives the parsed config
+ * @return true if successful, false if source cannot be read or parsed
+ */
+inline bool loadCached(const std::filesystem::path& source,
+                       const std::filesystem::path& cache,
+                       json& config,
+                       const CacheOptions& options = {}) {
+    // Stamped before reading, so a source changing meanwhile leaves a stale, not a wrong, cache
+    detail::SourceStamp stamp;
+    if (!detail::stampOf(source, stamp)) {
+        PLOG_ERROR << "Failed to stat config source: " << source;
+        return false;
+    }
+
+    ByteArray source_bytes;
+    bool source_read = false;
+
+    std::error_code ec;
+    if (std::filesystem::is_regular_file(cache, ec)) {
+        file_io::MappedFile mapped(cache, file_io::AccessHint::Sequential);
+        detail::CacheHeader header{};
+        if (mapped.isOpen() && mapped.size() >= sizeof(header)) {
+            std::memcpy(&header, mapped.data(), sizeof(header));
+        }
+
+        bool valid = std::memcmp(header.magic, detail::cache_magic, sizeof(header.magic)) == 0 &&
+                     header.format == detail::cache_format && header.sourceSize == stamp.size &&
+                     header.sourceTime == stamp.time &&
+                     header.payloadSize == mapped.size() - sizeof(header);
+        if (valid && options.verifyHash) {
+            source_read = file_io::read(source, source_bytes);
+            valid = source_read && detail::cacheHash(source_bytes) == header.sourceHash;
+        }
+
+        if (valid) {
+            const ByteView payload = mapped.view().subview(sizeof(header));
+            if (detail::cacheHash(payload) == header.payloadHash) {
+                if (detail::CacheDecoder(payload).decodeAll(config)) {
+                    return true;
+                }
+            }
+            PLOG_WARNING << "Config cache is damaged, rebuilding: " << cache;
+        }
+    }
+
+    if (!source_read && !file_io::read(source, source_bytes)) {
+        PLOG_ERROR << "Failed to read config source: " << source;
+        return false;
+    }
+    config = json::parse(source_bytes.begin(), source_bytes.end(), nullptr, false);
+    if (config.is_discarded()) {
+        PLOG_ERROR << "Failed to parse config: " << source;
+        return false;
+    }
+
+    if (!detail::writeCache(
+            cache, config, stamp, detail::cacheHash(source_bytes), options.durability)) {
+        PLOG_WARNING << "Failed to write config cache: " << cache;
+    }
+    return true;
+}
+
+}  // namespace JsonConfig
+
+}  // namespace msh::utils
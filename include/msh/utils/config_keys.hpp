@@ -0,0 +1,231 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "JsonConfig.hpp"
+
+namespace msh::utils {
+
+namespace JsonConfig {
+
+class KeySet;
+class Values;
+
+/**
+ * @brief Typed handle to one config value, created by KeySet::add
+ *
+ * A handle is only an offset into the value table of its KeySet; reading it through Values is a
+ * plain load without hashing, type checks or logging.
+ */
+template <typename T>
+class Key {
+  public:
+    using value_type = T;
+
+    const T& get(const Values& values) const noexcept;
+
+  private:
+    friend class KeySet;
+    friend class Values;
+
+    explicit Key(const size_t offset) noexcept : m_offset(offset) {}
+
+    size_t m_offset;
+};
+
+/**
+ * @brief Flat table holding one resolved value per key of a KeySet
+ */
+class Values {
+  public:
+    Values() = default;
+
+    Values(Values&& other) noexcept = default;
+
+    Values& operator=(Values&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            m_storage = std::move(other.m_storage);
+            m_destructors = std::move(other.m_destructors);
+        }
+        return *this;
+    }
+
+    Values(const Values&) = delete;
+    Values& operator=(const Values&) = delete;
+
+    ~Values() {
+        destroy();
+    }
+
+    /**
+     * @brief Value of key; key must come from the KeySet these values were resolved from
+     */
+    template <typename T>
+    const T& operator[](const Key<T>& key) const noexcept {
+        return *std::launder(reinterpret_cast<const T*>(m_storage.get() + key.m_offset));
+    }
+
+  private:
+    friend class KeySet;
+
+    using Destructor = void (*)(std::byte*);
+
+    std::unique_ptr<std::byte[]> m_storage;
+    // Offsets and destructors of the values that are not trivially destructible
+    std::vector<std::pair<size_t, Destructor>> m_destructors;
+
+    void destroy() noexcept {
+        for (const auto& [offset, destructor] : m_destructors) {
+            destructor(m_storage.get() + offset);
+        }
+        m_destructors.clear();
+    }
+};
+
+template <typename T>
+const T& Key<T>::get(const Values& values) const noexcept {
+    return values[*this];
+}
+
+/**
+ * @brief Set of config keys declared once at startup and resolved together
+ *
+ * Each key is declared with its default and optional range and gets a slot in a flat table.
+ * resolve() looks every key up once, with the same conversion rules as getSafe, and stores either
+ * the value or the default; problems are collected into a Report rather than logged. Keys
+ * starting with '/' are JSON pointers to nested values, anything else names a top-level member.
+ *
+ * Declare all keys before resolving; add() is not thread-safe.
+ */
+class KeySet {
+  public:
+    template <typename T>
+    Key<T> add(std::string key, detail::identity_t<T> default_value) {
+        return addKey<T>(std::move(key), std::move(default_value), {});
+    }
+
+    /**
+     * @brief Declare a key whose value must lie within [min, max]
+     */
+    template <typename T>
+    Key<T> add(std::string key,
+               detail::identity_t<T> default_value,
+               detail::identity_t<T> min,
+               detail::identity_t<T> max) {
+        return addKey<T>(std::move(key),
+                         std::move(default_value),
+                         [min = std::move(min), max = std::move(max)](const T& value) {
+                             return !(value < min) && !(max < value);
+                         });
+    }
+
+    size_t size() const noexcept {
+        return m_entries.size();
+    }
+
+    /**
+     * @brief Resolve every key against root into a new value table
+     * @param report Receives an issue for every key that fell back to its default, may be null
+     */
+    Values resolve(const json& root, Report* report = nullptr) const {
+        Values values;
+        values.m_storage = std::make_unique<std::byte[]>(std::max<size_t>(m_size, 1));
+
+        for (const Entry& entry : m_entries) {
+            const json* jvalue = entry.key.empty() || entry.key[0] != '/'
+                                     ? detail::findMember(root, entry.key)
+                                     : detail::findPointer(root, entry.key);
+
+            std::byte* slot = values.m_storage.get() + entry.offset;
+            const auto kind = entry.construct(jvalue, slot);
+            if (entry.destructor != nullptr) {
+                values.m_destructors.emplace_back(entry.offset, entry.destructor);
+            }
+            if (kind.has_value() && report != nullptr) {
+                auto value = jvalue != nullptr ? detail::dumpForLog(*jvalue) : std::string();
+                report->issues.push_back({entry.key, *kind, std::move(value)});
+            }
+        }
+        return values;
+    }
+
+  private:
+    struct Entry {
+        std::string key;
+        size_t offset;
+        // Constructs the value or the default in the slot, returning why the default was used
+        std::function<std::optional<Issue::Kind>(const json*, std::byte*)> construct;
+        Values::Destructor destructor;
+    };
+
+    std::vector<Entry> m_entries;
+    size_t m_size = 0;
+
+    template <typename T>
+    Key<T> addKey(std::string key, T default_value, std::function<bool(const T&)> in_range) {
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+                      "Over-aligned config values are not supported");
+
+        const size_t offset = (m_size + alignof(T) - 1) / alignof(T) * alignof(T);
+        m_size = offset + sizeof(T);
+
+        Entry entry;
+        entry.key = std::move(key);
+        entry.offset = offset;
+        entry.construct = [default_value = std::move(default_value),
+                           in_range = std::move(in_range)](
+                              const json* jvalue, std::byte* slot) -> std::optional<Issue::Kind> {
+            std::optional<Issue::Kind> kind;
+            T value{};
+            if (jvalue == nullptr) {
+                kind = Issue::Kind::Missing;
+            } else if (jvalue->is_null()) {
+                kind = Issue::Kind::Null;
+            } else {
+                switch (detail::convert(*jvalue, value)) {
+                    case detail::ConvertStatus::Ok:
+                        if (in_range && !in_range(value)) {
+                            kind = Issue::Kind::OutOfRange;
+                        }
+                        break;
+                    case detail::ConvertStatus::OutOfRange: kind = Issue::Kind::OutOfRange; break;
+                    case detail::ConvertStatus::ConversionFailed:
+                        kind = Issue::Kind::ConversionFailed;
+                        break;
+                    case detail::ConvertStatus::InvalidType: kind = Issue::Kind::InvalidType; break;
+                }
+            }
+
+            if (kind.has_value()) {
+                new (slot) T(default_value);
+            } else {
+                new (slot) T(std::move(value));
+            }
+            return kind;
+        };
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            entry.destructor = [](std::byte* slot) {
+                std::launder(reinterpret_cast<T*>(slot))->~T();
+            };
+        } else {
+            entry.destructor = nullptr;
+        }
+
+        m_entries.push_back(std::move(entry));
+        return Key<T>(offset);
+    }
+};
+
+}  // namespace JsonConfig
+
+}  // namespace msh::utils
@@ -0,0 +1,324 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <plog/Log.h>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "JsonConfig.hpp"
+#include "byte_array.hpp"
+#include "config_keys.hpp"
+#include "file_io.hpp"
+
+namespace msh::utils {
+
+namespace JsonConfig {
+
+/**
+ * @brief Immutable parsed config published by a Store
+ */
+struct Snapshot {
+    json root;
+    /// Increases by one with every successful load, starting at 1
+    uint64_t version = 0;
+    /// Keys of the store resolved against root
+    Values values;
+    /// Keys that fell back to their default in this snapshot
+    Report report;
+};
+
+/**
+ * @brief Config file shared between threads, reloaded without blocking readers
+ *
+ * Every successful load publishes a new immutable Snapshot. Readers keep the snapshot they hold
+ * alive through its shared_ptr, so a reload never invalidates a view in use; the old snapshot is
+ * freed when its last holder lets go. A failed load keeps the current snapshot.
+ *
+ * Hot paths should read through a Store::Reader, whose check for a newer snapshot is a single
+ * atomic load, and fixed keys through Key handles resolved into each snapshot.
+ */
+class Store {
+  public:
+    using SnapshotPtr = std::shared_ptr<const Snapshot>;
+
+    /**
+     * @brief Per-thread read handle caching the latest snapshot
+     *
+     * get() is wait-free while no reload happened since the last call. A Reader must not be
+     * shared between threads and must not outlive its Store.
+     */
+    class Reader {
+      public:
+        explicit Reader(const Store& store) : m_store(&store) {
+            refresh();
+        }
+
+        /**
+         * @brief Latest snapshot; the reference stays valid until the next call on this Reader
+         */
+        const Snapshot& get() {
+            if (m_store->m_version.load(std::memory_order_acquire) != m_version) {
+                refresh();
+            }
+            return *m_snapshot;
+        }
+
+        const Snapshot* operator->() {
+            return &get();
+        }
+
+        /**
+         * @brief Value of a key of the store's KeySet in the latest snapshot
+         */
+        template <typename T>
+        const T& get(const Key<T>& key) {
+            return get().values[key];
+        }
+
+      private:
+        const Store* m_store;
+        SnapshotPtr m_snapshot;
+        uint64_t m_version = 0;
+
+        void refresh() {
+            m_snapshot = m_store->snapshot();
+            m_version = m_snapshot->version;
+        }
+    };
+
+    /**
+     * @brief Create a store for path; nothing is read until load() or reload()
+     * @param keys Keys resolved into every snapshot, declared before the store is created
+     *
+     * Until the first successful load the snapshot holds a null document with version 0 and every
+     * key at its default.
+     */
+    explicit Store(std::filesystem::path path, KeySet keys = KeySet())
+        : m_path(std::move(path)), m_keys(std::move(keys)) {
+        auto snapshot = std::make_shared<Snapshot>();
+        snapshot->values = m_keys.resolve(snapshot->root, &snapshot->report);
+        m_current = std::move(snapshot);
+    }
+
+    Store(const Store&) = delete;
+    Store& operator=(const Store&) = delete;
+
+    ~Store() {
+        unwatch();
+    }
+
+    const std::filesystem::path& path() const noexcept {
+        return m_path;
+    }
+
+    /**
+     * @brief Read and parse the file, publishing a new snapshot on success
+     * @return True if a new snapshot was published
+     */
+    bool reload() {
+        // Serializes loads so versions are published in order
+        std::lock_guard<std::mutex> load_lock(m_loadMutex);
+
+        ByteArray bytes;
+        if (!file_io::read(m_path, bytes)) {
+            PLOG_ERROR << "Failed to load config: " << m_path;
+            return false;
+        }
+
+        auto snapshot = std::make_shared<Snapshot>();
+        snapshot->root = json::parse(bytes.begin(), bytes.end(), nullptr, false);
+        if (snapshot->root.is_discarded()) {
+            PLOG_ERROR << "Failed to parse config: " << m_path;
+            return false;
+        }
+        const uint64_t version = m_version.load(std::memory_order_relaxed) + 1;
+        snapshot->version = version;
+        snapshot->values = m_keys.resolve(snapshot->root, &snapshot->report);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_current = std::move(snapshot);
+        }
+        // Published after the pointer so a Reader seeing the new version finds the new snapshot
+        m_version.store(version, std::memory_order_release);
+        return true;
+    }
+
+    bool load() {
+        return reload();
+    }
+
+    /**
+     * @brief Current snapshot; holding it keeps it alive across reloads
+     */
+    SnapshotPtr snapshot() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_current;
+    }
+
+    uint64_t version() const noexcept {
+        return m_version.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Reload automatically whenever the file changes
+     *
+     * Uses inotify on the parent directory on Linux, so replacing the file by rename is seen as
+     * well; other platforms poll the modification time every poll_interval.
+     *
+     * @return True if watching started or was already active
+     */
+    bool watch(const std::chrono::milliseconds poll_interval = std::chrono::milliseconds(1000)) {
+        if (m_watcher.joinable()) {
+            return true;
+        }
+        m_stop = false;
+
+#if defined(__linux__)
+        const int notify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (notify_fd >= 0) {
+            auto directory = m_path.parent_path();
+            if (directory.empty()) {
+                directory = ".";
+            }
+            const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+            if (::inotify_add_watch(notify_fd, directory.c_str(), mask) < 0) {
+                PLOG_ERROR << "Failed to watch directory: " << directory;
+                ::close(notify_fd);
+                return false;
+            }
+            if (::pipe(m_wakeFds) != 0) {
+                PLOG_ERROR << "Failed to create watcher wake pipe";
+                ::close(notify_fd);
+                return false;
+            }
+            m_watcher = std::thread([this, notify_fd]() { watchNotify(notify_fd); });
+            return true;
+        }
+        PLOG_WARNING << "inotify unavailable, polling config: " << m_path;
+#endif
+
+        m_watcher = std::thread([this, poll_interval]() { watchPoll(poll_interval); });
+        return true;
+    }
+
+    /**
+     * @brief Stop watching; a reload in progress completes first
+     */
+    void unwatch() {
+        if (!m_watcher.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_stopMutex);
+            m_stop = true;
+        }
+        m_stopCondition.notify_all();
+#if defined(__linux__)
+        if (m_wakeFds[1] >= 0) {
+            const char byte = 0;
+            [[maybe_unused]] const auto written = ::write(m_wakeFds[1], &byte, 1);
+        }
+#endif
+        m_watcher.join();
+#if defined(__linux__)
+        for (int& fd : m_wakeFds) {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+#endif
+    }
+
+    bool isWatching() const noexcept {
+        return m_watcher.joinable();
+    }
+
+  private:
+    std::filesystem::path m_path;
+    const KeySet m_keys;
+
+    mutable std::mutex m_mutex;
+    SnapshotPtr m_current;
+    std::atomic<uint64_t> m_version{0};
+    std::mutex m_loadMutex;
+
+    std::thread m_watcher;
+    std::mutex m_stopMutex;
+    std::condition_variable m_stopCondition;
+    bool m_stop = false;
+#if defined(__linux__)
+    int m_wakeFds[2] = {-1, -1};
+
+    void watchNotify(const int notify_fd) {
+        const auto name = m_path.filename().native();
+        alignas(inotify_event) char buffer[4096];
+
+        for (;;) {
+            pollfd fds[2] = {{notify_fd, POLLIN, 0}, {m_wakeFds[0], POLLIN, 0}};
+            if (::poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                PLOG_ERROR << "Config watcher poll failed";
+                break;
+            }
+            if (fds[1].revents != 0) {
+                break;
+            }
+
+            // Drain every queued event, reloading at most once per batch
+            bool changed = false;
+            ssize_t length = 0;
+            while ((length = ::read(notify_fd, buffer, sizeof(buffer))) > 0) {
+                for (ssize_t offset = 0; offset < length;) {
+                    const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                    if (event->len != 0 && name == event->name) {
+                        changed = true;
+                    }
+                    offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                }
+            }
+            if (changed) {
+                reload();
+            }
+        }
+        ::close(notify_fd);
+    }
+#endif
+
+    void watchPoll(const std::chrono::milliseconds interval) {
+        std::error_code ec;
+        auto last = std::filesystem::last_write_time(m_path, ec);
+
+        std::unique_lock<std::mutex> lock(m_stopMutex);
+        while (!m_stopCondition.wait_for(lock, interval, [this]() { return m_stop; })) {
+            const auto current = std::filesystem::last_write_time(m_path, ec);
+            if (!ec && current != last) {
+                last = current;
+                lock.unlock();
+                reload();
+                lock.lock();
+            }
+        }
+    }
+};
+
+}  // namespace JsonConfig
+
+}  // namespace msh::utils
@@ -0,0 +1,121 @@
+#ifndef MSH_UTILS_CPU_FEATURES_HPP
+#define MSH_UTILS_CPU_FEATURES_HPP
+
+#include <cstdint>
+
+// Define MSH_UTILS_NO_SIMD to build every kernel with its portable scalar implementation only.
+#if !defined(MSH_UTILS_NO_SIMD)
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MSH_UTILS_X86 1
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MSH_UTILS_SSE2 1
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define MSH_UTILS_NEON 1
+#endif
+#endif
+
+#if defined(MSH_UTILS_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <immintrin.h>
+#endif
+
+#if defined(MSH_UTILS_NEON)
+#include <arm_neon.h>
+#endif
+
+// Marks a function that may use instructions beyond the compiler's baseline target. MSVC accepts
+// any intrinsic without it; GCC and Clang need it to compile the function body.
+#if defined(MSH_UTILS_X86) && !(defined(_MSC_VER) && !defined(__clang__))
+#define MSH_UTILS_TARGET(features) __attribute__((target(features)))
+#else
+#define MSH_UTILS_TARGET(features)
+#endif
+
+namespace msh::utils {
+
+namespace cpu {
+
+/**
+ * @brief Instruction set extensions usable by the current process
+ *
+ * An extension is only reported when both the CPU and the OS (register state saving) support it.
+ */
+struct Features {
+    bool ssse3 = false;
+    bool sse42 = false;
+    bool avx2 = false;
+};
+
+namespace detail {
+
+#if defined(MSH_UTILS_X86)
+inline void cpuid(uint32_t regs[4], const uint32_t leaf, const uint32_t subleaf) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = static_cast<uint32_t>(info[i]);
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+inline uint64_t xgetbv() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return _xgetbv(0);
+#else
+    uint32_t eax = 0;
+    uint32_t edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+inline Features detect() noexcept {
+    Features features;
+#if defined(MSH_UTILS_X86)
+    uint32_t regs[4] = {};
+    cpuid(regs, 0, 0);
+    const uint32_t max_leaf = regs[0];
+
+    cpuid(regs, 1, 0);
+    const uint32_t ecx = regs[2];
+    features.ssse3 = (ecx & (1u << 9)) != 0;
+    features.sse42 = (ecx & (1u << 20)) != 0;
+
+    const bool osxsave = (ecx & (1u << 27)) != 0;
+    const bool avx = (ecx & (1u << 28)) != 0;
+    // XMM and YMM state must both be enabled by the OS
+    const bool ymm_enabled = osxsave && (xgetbv() & 0x6) == 0x6;
+
+    if (max_leaf >= 7) {
+        cpuid(regs, 7, 0);
+        features.avx2 = avx && ymm_enabled && (regs[1] & (1u << 5)) != 0;
+    }
+#endif
+    return features;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Features of the running CPU, detected once on first use
+ */
+inline const Features& features() noexcept {
+    static const Features detected = detail::detect();
+    return detected;
+}
+
+}  // namespace cpu
+
+}  // namespace msh::utils
+
+#endif  // MSH_UTILS_CPU_FEATURES_HPP
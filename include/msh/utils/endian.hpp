@@ -0,0 +1,214 @@
+#ifndef MSH_UTILS_ENDIAN_HPP
+#define MSH_UTILS_ENDIAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "cpu_features.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <stdlib.h>
+#endif
+
+namespace msh::utils {
+
+namespace endian {
+
+enum class Order { Little, Big };
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+inline constexpr Order native = Order::Big;
+#else
+inline constexpr Order native = Order::Little;
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+inline uint16_t byteswap(const uint16_t value) noexcept {
+    return _byteswap_ushort(value);
+}
+inline uint32_t byteswap(const uint32_t value) noexcept {
+    return _byteswap_ulong(value);
+}
+inline uint64_t byteswap(const uint64_t value) noexcept {
+    return _byteswap_uint64(value);
+}
+#else
+inline uint16_t byteswap(const uint16_t value) noexcept {
+    return __builtin_bswap16(value);
+}
+inline uint32_t byteswap(const uint32_t value) noexcept {
+    return __builtin_bswap32(value);
+}
+inline uint64_t byteswap(const uint64_t value) noexcept {
+    return __builtin_bswap64(value);
+}
+#endif
+inline uint8_t byteswap(const uint8_t value) noexcept {
+    return value;
+}
+
+namespace detail {
+
+template <size_t Size>
+struct UnsignedOf;
+template <>
+struct UnsignedOf<1> {
+    using type = uint8_t;
+};
+template <>
+struct UnsignedOf<2> {
+    using type = uint16_t;
+};
+template <>
+struct UnsignedOf<4> {
+    using type = uint32_t;
+};
+template <>
+struct UnsignedOf<8> {
+    using type = uint64_t;
+};
+
+// Integers, floating point and enums of 1, 2, 4 or 8 bytes; bool has no portable wire size
+template <typename T>
+inline constexpr bool is_loadable_v =
+    (std::is_arithmetic_v<T> || std::is_enum_v<T>) && !std::is_same_v<T, bool> &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+template <typename T>
+using bits_t = typename UnsignedOf<sizeof(T)>::type;
+
+inline void swapScalar(uint8_t* data, const size_t count, const size_t width) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t* p = data + i * width;
+        if (width == 2) {
+            uint16_t value;
+            std::memcpy(&value, p, sizeof(value));
+            value = byteswap(value);
+            std::memcpy(p, &value, sizeof(value));
+        } else if (width == 4) {
+            uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+            value = byteswap(value);
+            std::memcpy(p, &value, sizeof(value));
+        } else {
+            uint64_t value;
+            std::memcpy(&value, p, sizeof(value));
+            value = byteswap(value);
+            std::memcpy(p, &value, sizeof(value));
+        }
+    }
+}
+
+// SIMD kernels swap whole blocks only and return the number of bytes they handled; the caller
+// finishes the tail with the next narrower kernel.
+
+#if defined(MSH_UTILS_SSE2)
+inline __m128i swapMaskSse2(const size_t width) {
+    switch (width) {
+        case 2: return _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+        case 4: return _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        default: return _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    }
+}
+
+MSH_UTILS_TARGET("ssse3")
+inline size_t swapSsse3(uint8_t* data, const size_t size, const size_t width) {
+    const __m128i mask = swapMaskSse2(width);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        auto* p = reinterpret_cast<__m128i*>(data + i);
+        _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), mask));
+    }
+    return i;
+}
+
+MSH_UTILS_TARGET("avx2")
+inline size_t swapAvx2(uint8_t* data, const size_t size, const size_t width) {
+    // The shuffle works per 128-bit lane, so the mask is the same in both
+    const __m256i mask = _mm256_broadcastsi128_si256(swapMaskSse2(width));
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        auto* p = reinterpret_cast<__m256i*>(data + i);
+        _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), mask));
+    }
+    return i;
+}
+#endif
+
+#if defined(MSH_UTILS_NEON)
+inline size_t swapNeon(uint8_t* data, const size_t size, const size_t width) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const uint8x16_t bytes = vld1q_u8(data + i);
+        vst1q_u8(data + i, width == 2   ? vrev16q_u8(bytes)
+                           : width == 4 ? vrev32q_u8(bytes)
+                                        : vrev64q_u8(bytes));
+    }
+    return i;
+}
+#endif
+
+}  // namespace detail
+
+/**
+ * @brief Reverse the byte order of count consecutive elements of width bytes, in place
+ * @param data First byte of the elements; no alignment is required
+ * @param count Number of elements
+ * @param width Element size: 1, 2, 4 or 8; 1 leaves the data unchanged
+ */
+inline void swapInPlace(uint8_t* data, const size_t count, const size_t width) {
+    if (width <= 1) {
+        return;
+    }
+    const size_t size = count * width;
+    size_t done = 0;
+#if defined(MSH_UTILS_SSE2)
+    if (cpu::features().avx2) {
+        done = detail::swapAvx2(data, size, width);
+    }
+    if (cpu::features().ssse3) {
+        done += detail::swapSsse3(data + done, size - done, width);
+    }
+#elif defined(MSH_UTILS_NEON)
+    done = detail::swapNeon(data, size, width);
+#endif
+    detail::swapScalar(data + done, (size - done) / width, width);
+}
+
+/**
+ * @brief Read a value stored in the given byte order at an unaligned address
+ */
+template <typename T>
+T load(const uint8_t* src, const Order order) noexcept {
+    static_assert(detail::is_loadable_v<T>, "T must be an integer, floating point or enum type");
+    detail::bits_t<T> bits;
+    std::memcpy(&bits, src, sizeof(bits));
+    if (order != native) {
+        bits = byteswap(bits);
+    }
+    T value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Write a value in the given byte order at an unaligned address
+ */
+template <typename T>
+void store(uint8_t* dst, const T value, const Order order) noexcept {
+    static_assert(detail::is_loadable_v<T>, "T must be an integer, floating point or enum type");
+    detail::bits_t<T> bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    if (order != native) {
+        bits = byteswap(bits);
+    }
+    std::memcpy(dst, &bits, sizeof(bits));
+}
+
+}  // namespace endian
+
+}  // namespace msh::utils
+
+#endif  // MSH_UTILS_ENDIAN_HPP
@@ -0,0 +1,377 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <plog/Log.h>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "byte_array.hpp"
+#include "byte_view.hpp"
+#include "file_io.hpp"
+
+namespace msh::utils {
+
+namespace file_io {
+
+/**
+ * @brief Options for loadDirectory() and loadFiles()
+ */
+struct LoadOptions {
+    /// Threads reading files, including the calling one; 0 means one per hardware thread
+    unsigned threads = 0;
+    /// Files a thread opens and asks the OS to prefetch before reading them one by one
+    size_t prefetch = 32;
+    /// Alignment of each file's data within the arena, a power of two
+    size_t alignment = 16;
+    /// Descend into subdirectories; loadDirectory() only
+    bool recursive = true;
+};
+
+class FileArena;
+
+namespace detail {
+
+struct PendingFile {
+    std::string key;
+    std::filesystem::path path;
+    uint64_t size;
+};
+
+inline bool loadArena(std::vector<PendingFile> pending,
+                      FileArena& files,
+                      const LoadOptions& options);
+
+}  // namespace detail
+
+/**
+ * @brief Contents of many files packed into one contiguous buffer, looked up by path
+ *
+ * Filled by loadDirectory() or loadFiles(). One allocation holds every file, so loading tens of
+ * thousands of small files costs neither a heap block per file nor the fragmentation they leave
+ * behind. Lookups binary search a sorted index and return views into the arena, which stay valid
+ * as long as the FileArena is neither destroyed nor reloaded. The arena always lives on the heap,
+ * even when it would fit ByteArray's inline buffer, so moving a FileArena keeps them valid.
+ */
+class FileArena {
+  public:
+    using size_type = std::size_t;
+
+    struct Entry {
+        /// Generic form of the path: relative to the directory, or as given to loadFiles()
+        std::string path;
+        size_type offset;
+        size_type size;
+    };
+
+    // Constructors
+    FileArena() = default;
+
+    // Capacity
+    /**
+     * @brief Number of files
+     */
+    size_type size() const noexcept {
+        return m_entries.size();
+    }
+    bool empty() const noexcept {
+        return m_entries.empty();
+    }
+
+    // Access
+    /**
+     * @brief Files in path order, which is also their order in the arena
+     */
+    const std::vector<Entry>& entries() const noexcept {
+        return m_entries;
+    }
+
+    ByteView view(const Entry& entry) const noexcept {
+        return m_arena.view().subview(entry.offset, entry.size);
+    }
+
+    /**
+     * @brief The whole arena, files separated by zeroed alignment padding
+     */
+    ByteView arena() const noexcept {
+        return m_arena.view();
+    }
+
+    bool contains(const std::filesystem::path& path) const {
+        return entry(path) != nullptr;
+    }
+
+    std::optional<ByteView> find(const std::filesystem::path& path) const {
+        const Entry* found = entry(path);
+        if (found == nullptr) {
+            return std::nullopt;
+        }
+        return view(*found);
+    }
+
+    /**
+     * @brief Contents of a file
+     * @throw std::out_of_range if the file was not loaded
+     */
+    ByteView at(const std::filesystem::path& path) const {
+        const Entry* found = entry(path);
+        if (found == nullptr) {
+            throw std::out_of_range("FileArena has no file " + path.generic_string());
+        }
+        return view(*found);
+    }
+
+    // Operations
+    void clear() noexcept {
+        m_arena.clear();
+        m_entries.clear();
+    }
+
+  private:
+    ByteArray m_arena;
+    std::vector<Entry> m_entries;
+
+    friend bool detail::loadArena(std::vector<detail::PendingFile> pending,
+                                  FileArena& files,
+                                  const LoadOptions& options);
+
+    const Entry* entry(const std::filesystem::path& path) const {
+        const std::string key = path.generic_string();
+        const auto it = std::lower_bound(
+            m_entries.begin(), m_entries.end(), key, [](const Entry& entry, const std::string& k) {
+                return entry.path < k;
+            });
+        return it != m_entries.end() && it->path == key ? &*it : nullptr;
+    }
+};
+
+namespace detail {
+
+// Worker threads for tasks units of work: LoadOptions::threads, but no more than there are tasks
+inline unsigned workerCount(const LoadOptions& options, const size_t tasks) {
+    unsigned threads = options.threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, tasks)));
+}
+
+/**
+ * @brief Fill in the size of every pending file, spreading the stat calls over the worker threads
+ */
+inline bool statFiles(std::vector<PendingFile>& pending, const LoadOptions& options) {
+    constexpr size_t batch = 64;
+    const size_t count = pending.size();
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+
+    const auto worker = [&] {
+        while (!failed) {
+            const size_t first = next.fetch_add(batch);
+            if (first >= count) {
+                break;
+            }
+            for (size_t i = first; i < std::min(count, first + batch); ++i) {
+                std::error_code ec;
+                pending[i].size = std::filesystem::file_size(pending[i].path, ec);
+                if (ec) {
+                    PLOG_ERROR << "Failed to get the size of " << pending[i].path << ": "
+                               << ec.message();
+                    failed = true;
+                    return;
+                }
+            }
+        }
+    };
+    runWorkers(workerCount(options, count / batch + 1), worker);
+    return !failed;
+}
+
+inline bool loadArena(std::vector<PendingFile> pending,
+                      FileArena& files,
+                      const LoadOptions& options) {
+    files.clear();
+    const size_t alignment = options.alignment;
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        PLOG_ERROR << "Arena alignment must be a power of two: " << alignment;
+        return false;
+    }
+
+    std::sort(pending.begin(), pending.end(), [](const PendingFile& a, const PendingFile& b) {
+        return a.key < b.key;
+    });
+    pending.erase(std::unique(pending.begin(),
+                              pending.end(),
+                              [](const PendingFile& a, const PendingFile& b) {
+                                  return a.key == b.key;
+                              }),
+                  pending.end());
+
+    // Lay the files out in path order, each slot running up to the start of the next one
+    std::vector<FileArena::Entry> entries;
+    entries.reserve(pending.size());
+    size_t total = 0;
+    for (auto& file : pending) {
+        total = (total + alignment - 1) & ~(alignment - 1);
+        entries.push_back({std::move(file.key), total, static_cast<size_t>(file.size)});
+        total += static_cast<size_t>(file.size);
+    }
+
+    // Every byte is overwritten by a read or zeroed as padding. A heap buffer even for a tiny
+    // arena, as the inline one would move with the FileArena and leave views dangling.
+    ByteArray arena;
+    if (!entries.empty()) {
+        arena.reserve(std::max(total, ByteArray::inline_capacity + 1));
+    }
+    arena.resize_for_overwrite(total);
+    uint8_t* const base = arena.data();
+
+    const size_t count = pending.size();
+    const size_t batch = std::max<size_t>(1, options.prefetch);
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+
+    const auto worker = [&] {
+        std::vector<File> batch_files(std::min(batch, count));
+        while (!failed) {
+            const size_t first = next.fetch_add(batch);
+            if (first >= count) {
+                break;
+            }
+            const size_t last = std::min(count, first + batch);
+
+            // Open the whole batch first so the OS reads the later files while the earlier ones
+            // are copied
+            for (size_t i = first; i < last; ++i) {
+                File& file = batch_files[i - first];
+                if (!file.openRead(pending[i].path)) {
+                    PLOG_ERROR << "Failed to open file for reading: " << pending[i].path;
+                    failed = true;
+                    return;
+                }
+                file.willNeed(0, 0);
+            }
+
+            for (size_t i = first; i < last; ++i) {
+                File& file = batch_files[i - first];
+                auto& entry = entries[i];
+                const int64_t result = file.readFullAt(base + entry.offset, entry.size, 0);
+                file.close();
+                if (result < 0) {
+                    PLOG_ERROR << "Failed to read file: " << pending[i].path;
+                    failed = true;
+                    return;
+                }
+                // A file that shrank since it was listed keeps what is left of it
+                entry.size = static_cast<size_t>(result);
+                const size_t slot_end = i + 1 < count ? entries[i + 1].offset : total;
+                if (slot_end > entry.offset + entry.size) {
+                    std::memset(base + entry.offset + entry.size,
+                                0,
+                                slot_end - entry.offset - entry.size);
+                }
+            }
+        }
+    };
+
+    runWorkers(workerCount(options, count / batch + (count % batch != 0 ? 1 : 0)), worker);
+
+    if (failed) {
+        return false;
+    }
+    files.m_arena = std::move(arena);
+    files.m_entries = std::move(entries);
+    return true;
+}
+
+// Lists the regular files under directory; sizes are left to statFiles()
+template <typename Iterator>
+bool listFiles(const std::filesystem::path& directory, std::vector<PendingFile>& pending) {
+    std::error_code ec;
+    for (Iterator it(directory, ec); !ec && it != Iterator(); it.increment(ec)) {
+        const auto& entry = *it;
+        if (!entry.is_regular_file(ec)) {
+            if (ec) {
+                break;
+            }
+            continue;
+        }
+        pending.push_back(
+            {entry.path().lexically_relative(directory).generic_string(), entry.path(), 0});
+    }
+    if (ec) {
+        PLOG_ERROR << "Failed to list directory " << directory << ": " << ec.message();
+        return false;
+    }
+    return true;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Load every regular file under a directory into one arena
+ *
+ * Files are keyed by their path relative to directory in generic form, e.g. "models/a.bin".
+ * The directory is walked on the calling thread, which mostly costs reads of directory blocks
+ * since entry types come with them; the files are then stat'ed in parallel, so the arena is
+ * allocated once before any file is opened. Threads then claim batches of LoadOptions::prefetch
+ * files in path order; each opens its whole batch and asks the OS to prefetch every file in it
+ * before reading them into their slots with positioned reads. A file that shrinks while loading
+ * keeps what is left; growth is ignored.
+ *
+ * @param directory Directory to load
+ * @param files Receives the contents; cleared on failure
+ * @param options Threads, prefetch depth, alignment and recursion
+ * @return true if successful, false if the directory cannot be listed or any file read
+ */
+inline bool loadDirectory(const std::filesystem::path& directory,
+                          FileArena& files,
+                          const LoadOptions& options = {}) {
+    std::vector<detail::PendingFile> pending;
+    const bool listed =
+        options.recursive
+            ? detail::listFiles<std::filesystem::recursive_directory_iterator>(directory, pending)
+            : detail::listFiles<std::filesystem::directory_iterator>(directory, pending);
+    if (!listed || !detail::statFiles(pending, options)) {
+        files.clear();
+        return false;
+    }
+    return detail::loadArena(std::move(pending), files, options);
+}
+
+/**
+ * @brief Load the files of a manifest into one arena, as loadDirectory() does
+ *
+ * Files are keyed by their path as given, in generic form; duplicates are loaded once.
+ *
+ * @param paths Files to load
+ * @param files Receives the contents; cleared on failure
+ * @param options Threads, prefetch depth and alignment
+ * @return true if successful, false if any file cannot be read
+ */
+inline bool loadFiles(const std::vector<std::filesystem::path>& paths,
+                      FileArena& files,
+                      const LoadOptions& options = {}) {
+    std::vector<detail::PendingFile> pending;
+    pending.reserve(paths.size());
+    for (const auto& path : paths) {
+        pending.push_back({path.generic_string(), path, 0});
+    }
+    if (!detail::statFiles(pending, options)) {
+        files.clear();
+        return false;
+    }
+    return detail::loadArena(std::move(pending), files, options);
+}
+
+}  // namespace file_io
+
+}  // namespace msh::utils
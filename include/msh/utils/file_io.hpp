@@ -1,15 +1,467 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
 #include <filesystem>
-#include <fstream>
+#include <initializer_list>
 #include <plog/Log.h>
+#include <random>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <climits>
+#endif
 
 #include "byte_array.hpp"
+#include "byte_chain.hpp"
+#include "byte_view.hpp"
 
 namespace msh::utils {
 
 namespace file_io {
 
+/**
+ * @brief Access pattern hint passed to the OS for mapped or streamed files
+ */
+enum class AccessHint { Normal, Sequential, Random };
+
+/**
+ * @brief How far write() pushes data towards stable storage before returning
+ */
+enum class Durability {
+    /// Leave flushing to the OS
+    None,
+    /// Flush file contents and the metadata needed to read them back (fdatasync)
+    Data,
+    /// Flush the file completely (fsync) and, for atomic writes, the directory entry as well
+    Full
+};
+
+/**
+ * @brief Options for write()
+ */
+struct WriteOptions {
+    /// Write to a temporary file in the same directory and rename it over the target, so readers
+    /// and crashes only ever see the old or the new contents. A symlink is followed and the file
+    /// it points to replaced; on POSIX systems the new file keeps the permission bits and, when
+    /// permitted, the owner of the one it replaces.
+    bool atomic = false;
+    Durability durability = Durability::None;
+};
+
+/**
+ * @brief Options for the parallel read()
+ */
+struct ParallelReadOptions {
+    /// Threads issuing reads, including the calling one; 0 means one per hardware thread
+    unsigned threads = 0;
+    /// Bytes per read, rounded down to a multiple of 4 KiB; threads claim whole chunks in order
+    size_t chunkSize = size_t{8} << 20;
+};
+
+namespace detail {
+
+/**
+ * @brief Thin move-only wrapper over a native file descriptor or handle
+ *
+ * All methods report failure through their return value and leave logging to the caller.
+ */
+class File {
+  public:
+#ifdef _WIN32
+    using native_handle_type = HANDLE;
+#else
+    using native_handle_type = int;
+#endif
+
+    File() = default;
+
+    ~File() {
+        close();
+    }
+
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+
+    File(File&& other) noexcept : m_handle(std::exchange(other.m_handle, invalidHandle())) {}
+
+    File& operator=(File&& other) noexcept {
+        if (this != &other) {
+            close();
+            m_handle = std::exchange(other.m_handle, invalidHandle());
+        }
+        return *this;
+    }
+
+    bool openRead(const std::filesystem::path& path, const AccessHint hint = AccessHint::Normal) {
+        close();
+#ifdef _WIN32
+        DWORD flags = FILE_ATTRIBUTE_NORMAL;
+        if (hint == AccessHint::Sequential) {
+            flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+        } else if (hint == AccessHint::Random) {
+            flags |= FILE_FLAG_RANDOM_ACCESS;
+        }
+        m_handle = CreateFileW(
+            path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+#else
+        m_handle = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        // Files start out with the normal access pattern, so that hint needs no extra call
+        if (isOpen() && hint != AccessHint::Normal) {
+            advise(0, 0, hint);
+        }
+#endif
+        return isOpen();
+    }
+
+    /**
+     * @brief Create or truncate a file for writing
+     * @param exclusive Fail instead if the file already exists
+     */
+    bool openWrite(const std::filesystem::path& path, const bool exclusive = false) {
+        close();
+#ifdef _WIN32
+        m_handle = CreateFileW(path.c_str(),
+                               GENERIC_WRITE,
+                               FILE_SHARE_READ,
+                               nullptr,
+                               exclusive ? CREATE_NEW : CREATE_ALWAYS,
+                               FILE_ATTRIBUTE_NORMAL,
+                               nullptr);
+#else
+        const int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (exclusive ? O_EXCL : O_TRUNC);
+        m_handle = ::open(path.c_str(), flags, 0666);
+#endif
+        return isOpen();
+    }
+
+    void close() noexcept {
+        if (isOpen()) {
+#ifdef _WIN32
+            CloseHandle(m_handle);
+#else
+            ::close(m_handle);
+#endif
+            m_handle = invalidHandle();
+        }
+    }
+
+    bool isOpen() const noexcept {
+        return m_handle != invalidHandle();
+    }
+
+    native_handle_type nativeHandle() const noexcept {
+        return m_handle;
+    }
+
+    bool size(uint64_t& out) const {
+#ifdef _WIN32
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(m_handle, &file_size)) {
+            return false;
+        }
+        out = static_cast<uint64_t>(file_size.QuadPart);
+#else
+        struct stat st {};
+        if (::fstat(m_handle, &st) != 0) {
+            return false;
+        }
+        out = static_cast<uint64_t>(st.st_size);
+#endif
+        return true;
+    }
+
+    /**
+     * @brief Read up to size bytes from the current position
+     * @return Number of bytes read, 0 at end of file, -1 on error
+     */
+    int64_t read(void* buffer, const size_t size) {
+#ifdef _WIN32
+        DWORD read_bytes = 0;
+        const auto request = static_cast<DWORD>(std::min<size_t>(size, max_io_size));
+        if (!ReadFile(m_handle, buffer, request, &read_bytes, nullptr)) {
+            return -1;
+        }
+        return static_cast<int64_t>(read_bytes);
+#else
+        ssize_t result;
+        do {
+            result = ::read(m_handle, buffer, std::min<size_t>(size, max_io_size));
+        } while (result < 0 && errno == EINTR);
+        return static_cast<int64_t>(result);
+#endif
+    }
+
+    /**
+     * @brief Read exactly size bytes unless the end of file is reached first
+     * @return Number of bytes read, -1 on error
+     */
+    int64_t readFull(void* buffer, const size_t size) {
+        size_t total = 0;
+        while (total < size) {
+            const int64_t result = read(static_cast<uint8_t*>(buffer) + total, size - total);
+            if (result < 0) {
+                return -1;
+            }
+            if (result == 0) {
+                break;
+            }
+            total += static_cast<size_t>(result);
+        }
+        return static_cast<int64_t>(total);
+    }
+
+    /**
+     * @brief Read up to size bytes at offset, leaving the current position alone on POSIX
+     *
+     * Safe to call from several threads at once on the same file.
+     * @return Number of bytes read, 0 at end of file, -1 on error
+     */
+    int64_t readAt(void* buffer, const size_t size, const uint64_t offset) {
+#ifdef _WIN32
+        OVERLAPPED overlapped{};
+        overlapped.Offset = static_cast<DWORD>(offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        DWORD read_bytes = 0;
+        const auto request = static_cast<DWORD>(std::min<size_t>(size, max_io_size));
+        if (!ReadFile(m_handle, buffer, request, &read_bytes, &overlapped)) {
+            return GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+        }
+        return static_cast<int64_t>(read_bytes);
+#else
+        ssize_t result;
+        do {
+            result = ::pread(m_handle,
+                             buffer,
+                             std::min<size_t>(size, max_io_size),
+                             static_cast<off_t>(offset));
+        } while (result < 0 && errno == EINTR);
+        return static_cast<int64_t>(result);
+#endif
+    }
+
+    /**
+     * @brief Read exactly size bytes at offset unless the end of file is reached first
+     * @return Number of bytes read, -1 on error
+     */
+    int64_t readFullAt(void* buffer, const size_t size, const uint64_t offset) {
+        size_t total = 0;
+        while (total < size) {
+            const int64_t result =
+                readAt(static_cast<uint8_t*>(buffer) + total, size - total, offset + total);
+            if (result < 0) {
+                return -1;
+            }
+            if (result == 0) {
+                break;
+            }
+            total += static_cast<size_t>(result);
+        }
+        return static_cast<int64_t>(total);
+    }
+
+    /**
+     * @brief Write all size bytes at the current position
+     * @return true if successful, false otherwise
+     */
+    bool writeAll(const void* buffer, const size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(buffer);
+        size_t total = 0;
+        while (total < size) {
+#ifdef _WIN32
+            DWORD written = 0;
+            const auto request = static_cast<DWORD>(std::min<size_t>(size - total, max_io_size));
+            if (!WriteFile(m_handle, bytes + total, request, &written, nullptr)) {
+                return false;
+            }
+            total += written;
+#else
+            const ssize_t result =
+                ::write(m_handle, bytes + total, std::min<size_t>(size - total, max_io_size));
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            total += static_cast<size_t>(result);
+#endif
+        }
+        return true;
+    }
+
+    /**
+     * @brief Write several buffers back to back at the current position
+     * @return true if successful, false otherwise
+     */
+    bool writeAll(const ByteView* buffers, size_t count) {
+#ifdef _WIN32
+        for (size_t i = 0; i < count; ++i) {
+            if (!writeAll(buffers[i].data(), buffers[i].size())) {
+                return false;
+            }
+        }
+        return true;
+#else
+        constexpr size_t max_iov = IOV_MAX < 1024 ? IOV_MAX : 1024;
+        iovec iov[max_iov];
+        size_t skip = 0;  // bytes of buffers[0] already written
+
+        while (count > 0) {
+            size_t batch = 0;
+            for (; batch < count && batch < max_iov; ++batch) {
+                const size_t offset = batch == 0 ? skip : 0;
+                iov[batch].iov_base = const_cast<uint8_t*>(buffers[batch].data() + offset);
+                iov[batch].iov_len = buffers[batch].size() - offset;
+            }
+
+            const ssize_t result = ::writev(m_handle, iov, static_cast<int>(batch));
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+
+            // Advance past fully written buffers and remember how far into the next one we got
+            auto written = static_cast<size_t>(result);
+            while (count > 0 && written >= buffers[0].size() - skip) {
+                written -= buffers[0].size() - skip;
+                skip = 0;
+                ++buffers;
+                --count;
+            }
+            skip += written;
+        }
+        return true;
+#endif
+    }
+
+    /**
+     * @brief Flush written data to stable storage
+     * @param data_only Skip metadata that is not needed to read the data back
+     * @return true if successful, false otherwise
+     */
+    bool sync(const bool data_only) {
+#ifdef _WIN32
+        (void)data_only;
+        return FlushFileBuffers(m_handle) != 0;
+#elif defined(__APPLE__)
+        (void)data_only;
+        return ::fsync(m_handle) == 0;
+#else
+        return (data_only ? ::fdatasync(m_handle) : ::fsync(m_handle)) == 0;
+#endif
+    }
+
+    /**
+     * @brief Forward an access pattern hint for a byte range, 0 length meaning up to the end
+     * @note Only effective where posix_fadvise is available; Windows takes hints at open time
+     */
+    void advise(const uint64_t offset, const uint64_t length, const AccessHint hint) noexcept {
+#if defined(POSIX_FADV_SEQUENTIAL)
+        int advice = POSIX_FADV_NORMAL;
+        if (hint == AccessHint::Sequential) {
+            advice = POSIX_FADV_SEQUENTIAL;
+        } else if (hint == AccessHint::Random) {
+            advice = POSIX_FADV_RANDOM;
+        }
+        ::posix_fadvise(
+            m_handle, static_cast<off_t>(offset), static_cast<off_t>(length), advice);
+#else
+        (void)offset;
+        (void)length;
+        (void)hint;
+#endif
+    }
+
+    /**
+     * @brief Ask the OS to drop cached pages of a byte range that will not be read again
+     */
+    void dropCache(const uint64_t offset, const uint64_t length) noexcept {
+#if defined(POSIX_FADV_DONTNEED)
+        ::posix_fadvise(
+            m_handle, static_cast<off_t>(offset), static_cast<off_t>(length), POSIX_FADV_DONTNEED);
+#else
+        (void)offset;
+        (void)length;
+#endif
+    }
+
+    /**
+     * @brief Ask the OS to start reading a byte range into the cache ahead of use, 0 length
+     * meaning up to the end
+     */
+    void willNeed(const uint64_t offset, const uint64_t length) noexcept {
+#if defined(POSIX_FADV_WILLNEED)
+        ::posix_fadvise(
+            m_handle, static_cast<off_t>(offset), static_cast<off_t>(length), POSIX_FADV_WILLNEED);
+#else
+        (void)offset;
+        (void)length;
+#endif
+    }
+
+  private:
+    // Largest single transfer; Windows takes a DWORD and Linux caps a call just below 2 GiB
+    static constexpr size_t max_io_size = size_t{1} << 30;
+
+    static native_handle_type invalidHandle() noexcept {
+#ifdef _WIN32
+        return INVALID_HANDLE_VALUE;
+#else
+        return -1;
+#endif
+    }
+
+    native_handle_type m_handle = invalidHandle();
+};
+
+/**
+ * @brief Run worker on the calling thread and threads - 1 others, returning once all are done
+ *
+ * Workers pull their share of the work from shared state, so if a thread cannot be started the
+ * ones already running still complete it.
+ */
+template <typename Worker>
+void runWorkers(const unsigned threads, const Worker& worker) {
+    std::vector<std::thread> workers;
+    workers.reserve(threads > 0 ? threads - 1 : 0);
+    for (unsigned t = 1; t < threads; ++t) {
+        try {
+            workers.emplace_back(worker);
+        } catch (const std::system_error&) {
+            break;
+        }
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+}
+
+}  // namespace detail
+
 /**
  * @brief Read binary data from a file into a ByteArray
  * @param path Path to the file to read
@@ -17,49 +469,769 @@ namespace file_io {
  * @return true if successful, false otherwise
  */
 inline bool read(const std::filesystem::path& path, ByteArray& bytes) {
-    std::ifstream file(path, std::ios::binary);
-    if (!file) {
+    detail::File file;
+    if (!file.openRead(path, AccessHint::Sequential)) {
         PLOG_ERROR << "Failed to open file for reading: " << path;
         return false;
     }
 
-    file.seekg(0, std::ios::end);
-    auto size = file.tellg();
-    file.seekg(0, std::ios::beg);
+    uint64_t size = 0;
+    if (!file.size(size)) {
+        PLOG_ERROR << "Failed to read file: " << path;
+        return false;
+    }
 
-    bytes.resize(static_cast<ByteArray::size_type>(size));
-    file.read(reinterpret_cast<char*>(bytes.data()), size);
-    
-    if (!file.good()) {
+    // The read overwrites every byte, so the buffer is not zero-filled first
+    bytes.resize_for_overwrite(static_cast<ByteArray::size_type>(size));
+    const int64_t result = file.readFull(bytes.data(), bytes.size());
+    if (result < 0) {
         PLOG_ERROR << "Failed to read file: " << path;
+        bytes.clear();
         return false;
     }
+    // The file may have shrunk since its size was taken
+    bytes.resize_for_overwrite(static_cast<ByteArray::size_type>(result));
     return true;
 }
 
 /**
- * @brief Write binary data from a ByteArray to a file
- * @param path Path to the file to write
- * @param bytes ByteArray containing the data to write
+ * @brief Read a file into a ByteArray with several threads reading disjoint ranges at once
+ *
+ * A single sequential stream keeps one request in flight and leaves fast NVMe devices and
+ * arrays far below their bandwidth. Here bytes is sized once, the file is split into aligned
+ * chunks, and each thread claims the next chunk and reads it with a positioned read straight
+ * into its part of bytes. Files of a single chunk are read on the calling thread.
+ *
+ * @param path Path to the file to read
+ * @param bytes ByteArray to store the read data
+ * @param options Number of threads and chunk size
  * @return true if successful, false otherwise
  */
-inline bool write(const std::filesystem::path& path, const ByteArray& bytes) {
-    std::ofstream file(path, std::ios::binary);
-    if (!file) {
-        PLOG_ERROR << "Failed to open file for writing: " << path;
+inline bool read(const std::filesystem::path& path,
+                 ByteArray& bytes,
+                 const ParallelReadOptions& options) {
+    if (options.chunkSize == 0) {
+        PLOG_ERROR << "Read chunk size must not be zero: " << path;
         return false;
     }
 
-    file.write(reinterpret_cast<const char*>(bytes.data()),
-               static_cast<std::streamsize>(bytes.size()));
-    
-    if (!file.good()) {
-        PLOG_ERROR << "Failed to write file: " << path;
+    detail::File file;
+    if (!file.openRead(path)) {
+        PLOG_ERROR << "Failed to open file for reading: " << path;
+        return false;
+    }
+
+    uint64_t file_size = 0;
+    if (!file.size(file_size)) {
+        PLOG_ERROR << "Failed to read file: " << path;
+        return false;
+    }
+
+    constexpr size_t alignment = 4096;
+    const auto size = static_cast<size_t>(file_size);
+    const size_t chunk = std::max(alignment, options.chunkSize / alignment * alignment);
+    const size_t chunks = size / chunk + (size % chunk != 0 ? 1 : 0);
+    unsigned threads = options.threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, chunks)));
+
+    // The reads overwrite every byte, so the buffer is not zero-filled first
+    bytes.resize_for_overwrite(static_cast<ByteArray::size_type>(size));
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    // Lowered when the file has shrunk since its size was taken
+    std::atomic<size_t> end{size};
+
+    const auto worker = [&] {
+        for (size_t i = next++; i < chunks && !failed; i = next++) {
+            const size_t offset = i * chunk;
+            const size_t length = std::min(chunk, size - offset);
+            const int64_t result = file.readFullAt(bytes.data() + offset, length, offset);
+            if (result < 0) {
+                failed = true;
+            } else if (static_cast<size_t>(result) < length) {
+                const size_t short_end = offset + static_cast<size_t>(result);
+                size_t current = end.load();
+                while (short_end < current && !end.compare_exchange_weak(current, short_end)) {
+                    // A failed exchange reloads current
+                }
+            }
+        }
+    };
+
+    detail::runWorkers(threads, worker);
+
+    if (failed) {
+        PLOG_ERROR << "Failed to read file: " << path;
+        bytes.clear();
+        return false;
+    }
+    bytes.resize_for_overwrite(static_cast<ByteArray::size_type>(end.load()));
+    return true;
+}
+
+namespace detail {
+
+/**
+ * @brief File an atomic write of path replaces: path itself, or the file a symlink points to
+ *
+ * A dangling symlink cannot be resolved and is replaced by the new file.
+ */
+inline std::filesystem::path atomicDestination(const std::filesystem::path& path) {
+    std::error_code ec;
+    if (!std::filesystem::is_symlink(std::filesystem::symlink_status(path, ec))) {
+        return path;
+    }
+    auto resolved = std::filesystem::canonical(path, ec);
+    return ec ? path : resolved;
+}
+
+/**
+ * @brief Give the temporary file of an atomic write the owner and mode of the file it replaces
+ * @return false if the mode cannot be copied; a new file keeps the mode it was created with
+ */
+inline bool matchReplacedFile(const File& file, const std::filesystem::path& path) {
+#ifdef _WIN32
+    (void)file;
+    (void)path;
+    return true;
+#else
+    struct stat st {};
+    if (::stat(path.c_str(), &st) != 0) {
+        return errno == ENOENT;
+    }
+    // Best effort, as only root may give a file away; the owner first, since changing it clears
+    // the set-id bits
+    if (st.st_uid != ::geteuid() || st.st_gid != ::getegid()) {
+        [[maybe_unused]] const int chowned = ::fchown(file.nativeHandle(), st.st_uid, st.st_gid);
+    }
+    return ::fchmod(file.nativeHandle(), st.st_mode & 07777) == 0;
+#endif
+}
+
+/**
+ * @brief Unused name for a temporary file next to path
+ */
+inline std::filesystem::path temporarySibling(const std::filesystem::path& path) {
+    thread_local std::mt19937_64 generator{std::random_device{}()};
+    const uint64_t value = generator();
+    const auto suffix = ByteView(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+
+    auto temporary = path;
+    temporary.replace_filename("." + path.filename().string() + "." + suffix.toHexString() +
+                               ".tmp");
+    return temporary;
+}
+
+/**
+ * @brief Atomically replace target by source, both in the same directory
+ */
+inline bool replaceFile(const std::filesystem::path& source,
+                        const std::filesystem::path& target,
+                        const Durability durability) {
+#ifdef _WIN32
+    DWORD flags = MOVEFILE_REPLACE_EXISTING;
+    if (durability != Durability::None) {
+        flags |= MOVEFILE_WRITE_THROUGH;
+    }
+    return MoveFileExW(source.c_str(), target.c_str(), flags) != 0;
+#else
+    if (::rename(source.c_str(), target.c_str()) != 0) {
         return false;
     }
+    if (durability == Durability::Full) {
+        // Persist the new directory entry as well
+        auto directory = target.parent_path();
+        if (directory.empty()) {
+            directory = ".";
+        }
+        const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        const bool synced = ::fsync(fd) == 0;
+        ::close(fd);
+        return synced;
+    }
     return true;
+#endif
 }
 
+/**
+ * @brief Sync and close a file opened by write(), then move it into place when atomic
+ * @param file File written to target
+ * @param target path, or the temporary sibling an atomic write goes to
+ * @param path File being written, resolved by atomicDestination() for an atomic write
+ * @param written Whether all data was written to file
+ * @return true if successful, false otherwise; a failed atomic write leaves no temporary behind
+ */
+inline bool finishWrite(File& file,
+                        const std::filesystem::path& target,
+                        const std::filesystem::path& path,
+                        bool written,
+                        const WriteOptions& options) {
+    if (written && options.atomic) {
+        written = matchReplacedFile(file, path);
+    }
+    if (written && options.durability != Durability::None) {
+        written = file.sync(options.durability == Durability::Data);
+    }
+    file.close();
+
+    if (!written) {
+        PLOG_ERROR << "Failed to write file: " << path;
+    } else if (options.atomic && !replaceFile(target, path, options.durability)) {
+        PLOG_ERROR << "Failed to replace file: " << path;
+        written = false;
+    }
+
+    if (!written && options.atomic) {
+        std::error_code ec;
+        std::filesystem::remove(target, ec);
+    }
+    return written;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Write several buffers back to back into a file, without concatenating them first
+ * @param path Path to the file to write
+ * @param buffers Buffers to write, in order
+ * @param count Number of buffers
+ * @param options Atomic replacement and durability
+ * @return true if successful, false otherwise
+ */
+inline bool write(const std::filesystem::path& path,
+                  const ByteView* buffers,
+                  const size_t count,
+                  const WriteOptions& options = {}) {
+    detail::File file;
+    const auto destination = options.atomic ? detail::atomicDestination(path) : path;
+    const auto target = options.atomic ? detail::temporarySibling(destination) : path;
+    if (!file.openWrite(target, options.atomic)) {
+        PLOG_ERROR << "Failed to open file for writing: " << path;
+        return false;
+    }
+
+    return detail::finishWrite(file, target, destination, file.writeAll(buffers, count), options);
+}
+
+inline bool write(const std::filesystem::path& path,
+                  const std::vector<ByteView>& buffers,
+                  const WriteOptions& options = {}) {
+    return write(path, buffers.data(), buffers.size(), options);
+}
+
+inline bool write(const std::filesystem::path& path,
+                  const std::initializer_list<ByteView> buffers,
+                  const WriteOptions& options = {}) {
+    return write(path, buffers.begin(), buffers.size(), options);
+}
+
+/**
+ * @brief Write the segments of chain into a file with vectored writes, without flattening it
+ * @param path Path to the file to write
+ * @param chain Bytes to write
+ * @param options Atomic replacement and durability
+ * @return true if successful, false otherwise
+ */
+inline bool write(const std::filesystem::path& path,
+                  const ByteChain& chain,
+                  const WriteOptions& options = {}) {
+    const auto buffers = chain.views();
+    return write(path, buffers.data(), buffers.size(), options);
+}
+
+/**
+ * @brief Write binary data to a file
+ * @param path Path to the file to write
+ * @param bytes Bytes to write, a ByteArray or any other ByteView
+ * @param options Atomic replacement and durability
+ * @return true if successful, false otherwise
+ */
+inline bool write(const std::filesystem::path& path,
+                  const ByteView bytes,
+                  const WriteOptions& options = {}) {
+    return write(path, &bytes, 1, options);
+}
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * The mapped bytes are exposed in place, without copying them into a ByteArray and without an
+ * up-front allocation. The mapping stays valid until close() is called or the object is destroyed.
+ */
+class MappedFile {
+  public:
+    using value_type = ByteArray::value_type;
+    using size_type = ByteArray::size_type;
+    using const_iterator = const value_type*;
+
+    MappedFile() = default;
+
+    explicit MappedFile(const std::filesystem::path& path,
+                        const AccessHint hint = AccessHint::Normal) {
+        open(path, hint);
+    }
+
+    ~MappedFile() {
+        close();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)),
+          m_size(std::exchange(other.m_size, 0)),
+          m_open(std::exchange(other.m_open, false)) {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_open = std::exchange(other.m_open, false);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Map a file read-only, replacing any current mapping
+     * @param path Path to the file to map
+     * @param hint Expected access pattern, forwarded to the OS
+     * @return true if successful, false otherwise
+     */
+    bool open(const std::filesystem::path& path, const AccessHint hint = AccessHint::Normal) {
+        close();
+
+        detail::File file;
+        if (!file.openRead(path, hint)) {
+            PLOG_ERROR << "Failed to open file for mapping: " << path;
+            return false;
+        }
+
+        uint64_t file_size = 0;
+        if (!file.size(file_size)) {
+            PLOG_ERROR << "Failed to get file size: " << path;
+            return false;
+        }
+
+        // Empty files cannot be mapped but are still valid, they just expose no bytes
+        if (file_size > 0) {
+#ifdef _WIN32
+            HANDLE mapping =
+                CreateFileMappingW(file.nativeHandle(), nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping == nullptr) {
+                PLOG_ERROR << "Failed to create file mapping: " << path;
+                return false;
+            }
+
+            void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            // The view keeps the mapping object and the file alive on its own
+            CloseHandle(mapping);
+            if (view == nullptr) {
+                PLOG_ERROR << "Failed to map file: " << path;
+                return false;
+            }
+#else
+            void* view = ::mmap(nullptr,
+                                static_cast<size_t>(file_size),
+                                PROT_READ,
+                                MAP_PRIVATE,
+                                file.nativeHandle(),
+                                0);
+            if (view == MAP_FAILED) {
+                PLOG_ERROR << "Failed to map file: " << path;
+                return false;
+            }
+#endif
+            // The mapping holds its own reference to the file, which can be closed now
+            m_data = static_cast<const value_type*>(view);
+            m_size = static_cast<size_type>(file_size);
+            advise(hint);
+        }
+
+        m_open = true;
+        return true;
+    }
+
+    /**
+     * @brief Unmap the file; the object can be reopened afterwards
+     */
+    void close() noexcept {
+        if (m_data != nullptr) {
+#ifdef _WIN32
+            UnmapViewOfFile(m_data);
+#else
+            ::munmap(const_cast<value_type*>(m_data), m_size);
+#endif
+        }
+        m_data = nullptr;
+        m_size = 0;
+        m_open = false;
+    }
+
+    /**
+     * @brief Change the access pattern hint of the current mapping
+     * @param hint Expected access pattern
+     * @return true if the hint was applied, false otherwise
+     * @note On Windows the hint can only be given when the file is opened, so this is a no-op
+     */
+    bool advise(const AccessHint hint) noexcept {
+        if (m_data == nullptr) {
+            return false;
+        }
+#ifdef _WIN32
+        (void)hint;
+        return true;
+#else
+        int advice = MADV_NORMAL;
+        if (hint == AccessHint::Sequential) {
+            advice = MADV_SEQUENTIAL;
+        } else if (hint == AccessHint::Random) {
+            advice = MADV_RANDOM;
+        }
+        return ::madvise(const_cast<value_type*>(m_data), m_size, advice) == 0;
+#endif
+    }
+
+    bool isOpen() const noexcept {
+        return m_open;
+    }
+
+    const value_type* data() const noexcept {
+        return m_data;
+    }
+    size_type size() const noexcept {
+        return m_size;
+    }
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    const_iterator begin() const noexcept {
+        return m_data;
+    }
+    const_iterator end() const noexcept {
+        return m_data + m_size;
+    }
+
+    ByteView view() const noexcept {
+        return ByteView(m_data, m_size);
+    }
+    operator ByteView() const noexcept {
+        return view();
+    }
+
+  private:
+    const value_type* m_data = nullptr;
+    size_type m_size = 0;
+    bool m_open = false;
+};
+
+/**
+ * @brief Options for the streaming Reader and Writer
+ */
+struct StreamOptions {
+    /// Bytes moved per read() call, and the size of the Writer's coalescing buffer
+    ByteArray::size_type bufferSize = ByteArray::size_type{1} << 20;
+    /// Access pattern hint forwarded to the OS when reading
+    AccessHint hint = AccessHint::Sequential;
+    /// Drop pages that were already read from the OS cache, so a single pass over a huge file
+    /// does not evict everything else (POSIX only)
+    bool dropCache = false;
+};
+
+/**
+ * @brief Reads a file chunk by chunk into a caller-supplied, reusable ByteArray
+ *
+ * @code
+ * file_io::Reader reader(path);
+ * ByteArray chunk;
+ * while (reader.read(chunk)) {
+ *     process(chunk);
+ * }
+ * if (!reader.eof()) { ... }
+ * @endcode
+ */
+class Reader {
+  public:
+    Reader() = default;
+
+    explicit Reader(const std::filesystem::path& path, const StreamOptions& options = {}) {
+        open(path, options);
+    }
+
+    /**
+     * @brief Open a file for streaming, closing any current one
+     * @param path Path to the file to read
+     * @param options Chunk size and OS hints
+     * @return true if successful, false otherwise
+     */
+    bool open(const std::filesystem::path& path, const StreamOptions& options = {}) {
+        close();
+        if (options.bufferSize == 0) {
+            PLOG_ERROR << "Stream buffer size must not be zero: " << path;
+            return false;
+        }
+        if (!m_file.openRead(path, options.hint)) {
+            PLOG_ERROR << "Failed to open file for reading: " << path;
+            return false;
+        }
+        m_options = options;
+        return true;
+    }
+
+    void close() noexcept {
+        m_file.close();
+        m_offset = 0;
+        m_eof = false;
+    }
+
+    bool isOpen() const noexcept {
+        return m_file.isOpen();
+    }
+
+    /**
+     * @brief Read the next chunk of up to StreamOptions::bufferSize bytes
+     * @param chunk Receives the bytes; its capacity is reused between calls
+     * @return true if at least one byte was read, false at end of file or on error
+     */
+    bool read(ByteArray& chunk) {
+        chunk.clear();
+        if (!isOpen() || m_eof) {
+            return false;
+        }
+
+        int64_t result = 0;
+        chunk.append_with(m_options.bufferSize, [&](uint8_t* tail, const size_t max_n) {
+            result = m_file.readFull(tail, max_n);
+            return result > 0 ? static_cast<size_t>(result) : 0;
+        });
+        if (result < 0) {
+            PLOG_ERROR << "Failed to read file at offset " << m_offset;
+            chunk.clear();
+            close();
+            return false;
+        }
+
+        if (m_options.dropCache && result > 0) {
+            m_file.dropCache(m_offset, static_cast<uint64_t>(result));
+        }
+        m_offset += static_cast<uint64_t>(result);
+        m_eof = static_cast<ByteArray::size_type>(result) < m_options.bufferSize;
+        return result > 0;
+    }
+
+    /**
+     * @brief Read the next chunk and feed it to digest, e.g. a hash::Crc32c, while it is hot in
+     * cache, so verifying a file needs no second pass
+     * @param chunk Receives the bytes; its capacity is reused between calls
+     * @param digest Any object with update(ByteView)
+     * @return true if at least one byte was read, false at end of file or on error
+     */
+    template <typename Digest>
+    bool read(ByteArray& chunk, Digest& digest) {
+        if (!read(chunk)) {
+            return false;
+        }
+        digest.update(chunk.view());
+        return true;
+    }
+
+    /**
+     * @brief Whether the whole file has been read; false after a read error
+     */
+    bool eof() const noexcept {
+        return m_eof;
+    }
+
+    /**
+     * @brief Number of bytes consumed so far
+     */
+    uint64_t offset() const noexcept {
+        return m_offset;
+    }
+
+  private:
+    detail::File m_file;
+    StreamOptions m_options;
+    uint64_t m_offset = 0;
+    bool m_eof = false;
+};
+
+/**
+ * @brief Writes a file incrementally, coalescing small writes into StreamOptions::bufferSize
+ *
+ * Chunks at least as large as the buffer are written straight through without copying. The
+ * destructor flushes remaining data, but only close() reports whether that succeeded.
+ */
+class Writer {
+  public:
+    Writer() = default;
+
+    explicit Writer(const std::filesystem::path& path, const StreamOptions& options = {}) {
+        open(path, options);
+    }
+
+    ~Writer() {
+        close();
+    }
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    Writer(Writer&&) noexcept = default;
+
+    // Flushes and closes the current file first, and the buffers may not share a memory
+    // resource, so unlike the move constructor this may throw
+    Writer& operator=(Writer&& other) {
+        if (this != &other) {
+            close();
+            m_file = std::move(other.m_file);
+            m_buffer = std::move(other.m_buffer);
+            m_options = other.m_options;
+            m_offset = std::exchange(other.m_offset, 0);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Create or truncate a file for writing, closing any current one
+     * @param path Path to the file to write
+     * @param options Buffer size
+     * @return true if successful, false otherwise
+     */
+    bool open(const std::filesystem::path& path, const StreamOptions& options = {}) {
+        close();
+        if (!m_file.openWrite(path)) {
+            PLOG_ERROR << "Failed to open file for writing: " << path;
+            return false;
+        }
+        m_options = options;
+        m_buffer.reserve(options.bufferSize);
+        return true;
+    }
+
+    /**
+     * @brief Flush buffered data and close the file
+     * @return true if all data was written, false otherwise
+     */
+    bool close() {
+        if (!isOpen()) {
+            return true;
+        }
+        const bool flushed = flush();
+        m_file.close();
+        m_offset = 0;
+        return flushed;
+    }
+
+    bool isOpen() const noexcept {
+        return m_file.isOpen();
+    }
+
+    /**
+     * @brief Append bytes to the file
+     * @param chunk Bytes to write
+     * @return true if successful, false otherwise
+     */
+    bool write(const ByteView chunk) {
+        if (!isOpen()) {
+            PLOG_ERROR << "Write to a closed file";
+            return false;
+        }
+
+        if (m_buffer.size() + chunk.size() <= m_options.bufferSize) {
+            m_buffer.append(chunk);
+            m_offset += chunk.size();
+            return true;
+        }
+
+        if (!flush()) {
+            return false;
+        }
+        if (chunk.size() >= m_options.bufferSize) {
+            if (!m_file.writeAll(chunk.data(), chunk.size())) {
+                PLOG_ERROR << "Failed to write file at offset " << m_offset;
+                return false;
+            }
+        } else {
+            m_buffer.append(chunk);
+        }
+        m_offset += chunk.size();
+        return true;
+    }
+
+    /**
+     * @brief Append the segments of chain to the file
+     *
+     * A chain that does not fit the buffer is written with one vectored write after flushing.
+     *
+     * @param chain Bytes to write
+     * @return true if successful, false otherwise
+     */
+    bool write(const ByteChain& chain) {
+        if (!isOpen()) {
+            PLOG_ERROR << "Write to a closed file";
+            return false;
+        }
+
+        if (m_buffer.size() + chain.size() <= m_options.bufferSize) {
+            m_buffer.append_with(chain.size(), [&chain](uint8_t* tail, size_t) {
+                chain.copyTo(tail);
+                return chain.size();
+            });
+            m_offset += chain.size();
+            return true;
+        }
+
+        if (!flush()) {
+            return false;
+        }
+        const auto buffers = chain.views();
+        if (!m_file.writeAll(buffers.data(), buffers.size())) {
+            PLOG_ERROR << "Failed to write file at offset " << m_offset;
+            return false;
+        }
+        m_offset += chain.size();
+        return true;
+    }
+
+    /**
+     * @brief Hand buffered data to the OS
+     * @return true if successful, false otherwise
+     */
+    bool flush() {
+        if (m_buffer.empty()) {
+            return true;
+        }
+        const bool written = m_file.writeAll(m_buffer.data(), m_buffer.size());
+        if (!written) {
+            PLOG_ERROR << "Failed to write file at offset " << m_offset - m_buffer.size();
+        }
+        m_buffer.clear();
+        return written;
+    }
+
+    /**
+     * @brief Number of bytes accepted so far, including buffered ones
+     */
+    uint64_t offset() const noexcept {
+        return m_offset;
+    }
+
+  private:
+    detail::File m_file;
+    ByteArray m_buffer;
+    StreamOptions m_options;
+    uint64_t m_offset = 0;
+};
+
 }  // namespace file_io
 
 }  // namespace msh::utils
\ No newline at end of file
@@ -0,0 +1,404 @@
+#ifndef MSH_UTILS_HASH_HPP
+#define MSH_UTILS_HASH_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "cpu_features.hpp"
+
+#if defined(MSH_UTILS_NEON) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+namespace msh::utils {
+
+namespace hash {
+
+namespace detail {
+
+// Seed-independent constants of wyhash
+inline constexpr uint64_t secret[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+                                       0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+// 64x64 to 128-bit multiply, returning the low half in a and the high half in b
+inline void mum(uint64_t& a, uint64_t& b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    const __uint128_t product = static_cast<__uint128_t>(a) * b;
+    a = static_cast<uint64_t>(product);
+    b = static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    a = _umul128(a, b, &b);
+#else
+    const uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a),
+                   lb = static_cast<uint32_t>(b);
+    const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    const uint64_t t = rl + (rm0 << 32);
+    uint64_t carry = t < rl ? 1 : 0;
+    const uint64_t lo = t + (rm1 << 32);
+    carry += lo < t ? 1 : 0;
+    a = lo;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+inline uint64_t mix(uint64_t a, uint64_t b) noexcept {
+    mum(a, b);
+    return a ^ b;
+}
+
+// Native byte order; hashes are meant for in-process tables, not for storage
+inline uint64_t read8(const uint8_t* p) noexcept {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t read4(const uint8_t* p) noexcept {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+// Up to three bytes, without reading past the end
+inline uint64_t read3(const uint8_t* p, const size_t size) noexcept {
+    return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[size >> 1]) << 8) |
+           p[size - 1];
+}
+
+// Hash of at most 16 bytes
+inline void smallInput(const uint8_t* p, const size_t size, uint64_t& a, uint64_t& b) noexcept {
+    if (size >= 4) {
+        const size_t step = (size >> 3) << 2;
+        a = (read4(p) << 32) | read4(p + step);
+        b = (read4(p + size - 4) << 32) | read4(p + size - 4 - step);
+    } else if (size > 0) {
+        a = read3(p, size);
+        b = 0;
+    } else {
+        a = 0;
+        b = 0;
+    }
+}
+
+inline uint64_t finish(uint64_t a, uint64_t b, const uint64_t seed, const size_t size) noexcept {
+    a ^= secret[1];
+    b ^= seed;
+    mum(a, b);
+    return mix(a ^ secret[0] ^ size, b ^ secret[1]);
+}
+
+// Consumes one 48-byte stripe into three independent lanes
+inline void stripe(const uint8_t* p, uint64_t& seed, uint64_t& see1, uint64_t& see2) noexcept {
+    seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+    see1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ see1);
+    see2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ see2);
+}
+
+// Folds the last 1 to 48 bytes, which end at p + size; the 16 bytes before p must be readable
+// when size is below 16
+inline void tail(const uint8_t* p, size_t size, uint64_t& seed, uint64_t& a, uint64_t& b) noexcept {
+    while (size > 16) {
+        seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+        p += 16;
+        size -= 16;
+    }
+    a = read8(p + size - 16);
+    b = read8(p + size - 8);
+}
+
+// CRC-32C (Castagnoli), reflected polynomial
+inline constexpr uint32_t crc_polynomial = 0x82F63B78u;
+
+// Slicing-by-8 tables: table[k][b] is the CRC of byte b followed by k zero bytes
+inline constexpr std::array<std::array<uint32_t, 256>, 8> crc_table = [] {
+    std::array<std::array<uint32_t, 256>, 8> table{};
+    for (uint32_t b = 0; b < 256; ++b) {
+        uint32_t crc = b;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ ((crc & 1u) != 0 ? crc_polynomial : 0u);
+        }
+        table[0][b] = crc;
+    }
+    for (size_t k = 1; k < 8; ++k) {
+        for (size_t b = 0; b < 256; ++b) {
+            const uint32_t previous = table[k - 1][b];
+            table[k][b] = (previous >> 8) ^ table[0][previous & 0xFF];
+        }
+    }
+    return table;
+}();
+
+// Works on the inverted register, like the kernels below
+inline uint32_t crc32cScalar(uint32_t crc, const uint8_t* p, size_t size) noexcept {
+    for (; size >= 8; p += 8, size -= 8) {
+        const uint32_t low = static_cast<uint32_t>(read4(p)) ^ crc;
+        const uint32_t high = static_cast<uint32_t>(read4(p + 4));
+        crc = crc_table[7][low & 0xFF] ^ crc_table[6][(low >> 8) & 0xFF] ^
+              crc_table[5][(low >> 16) & 0xFF] ^ crc_table[4][low >> 24] ^
+              crc_table[3][high & 0xFF] ^ crc_table[2][(high >> 8) & 0xFF] ^
+              crc_table[1][(high >> 16) & 0xFF] ^ crc_table[0][high >> 24];
+    }
+    for (; size > 0; ++p, --size) {
+        crc = (crc >> 8) ^ crc_table[0][(crc ^ *p) & 0xFF];
+    }
+    return crc;
+}
+
+// Product of two polynomials modulo the CRC polynomial, in the reflected bit order
+constexpr uint32_t crcMultiply(uint32_t a, uint32_t b) noexcept {
+    uint32_t product = 0;
+    for (uint32_t bit = 1u << 31; bit != 0; bit >>= 1) {
+        if ((a & bit) != 0) {
+            product ^= b;
+        }
+        b = (b & 1u) != 0 ? (b >> 1) ^ crc_polynomial : b >> 1;
+    }
+    return product;
+}
+
+// x^(8 * size) modulo the CRC polynomial: multiplying a CRC register by it appends size zero
+// bytes
+constexpr uint32_t crcShift(const size_t size) noexcept {
+    uint32_t result = 1u << 31;  // x^0
+    uint32_t power = 1u << 23;   // x^8
+    for (size_t n = size; n != 0; n >>= 1) {
+        if ((n & 1) != 0) {
+            result = crcMultiply(result, power);
+        }
+        power = crcMultiply(power, power);
+    }
+    return result;
+}
+
+#if defined(MSH_UTILS_X86)
+// The CRC instruction has a latency of three cycles but a throughput of one, so large inputs are
+// split into three interleaved streams that are merged by shifting the first two forward
+inline constexpr size_t crc_lane_size = 4096;
+inline constexpr uint32_t crc_lane_shift = crcShift(crc_lane_size);
+
+MSH_UTILS_TARGET("sse4.2")
+inline uint32_t crc32cSse42(uint32_t crc, const uint8_t* p, size_t size) noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+    uint64_t wide = crc;
+    for (; size >= 3 * crc_lane_size; p += 3 * crc_lane_size, size -= 3 * crc_lane_size) {
+        uint64_t second = 0;
+        uint64_t third = 0;
+        for (size_t i = 0; i < crc_lane_size; i += 8) {
+            wide = _mm_crc32_u64(wide, read8(p + i));
+            second = _mm_crc32_u64(second, read8(p + crc_lane_size + i));
+            third = _mm_crc32_u64(third, read8(p + 2 * crc_lane_size + i));
+        }
+        wide = crcMultiply(crcMultiply(static_cast<uint32_t>(wide), crc_lane_shift) ^
+                               static_cast<uint32_t>(second),
+                           crc_lane_shift) ^
+               static_cast<uint32_t>(third);
+    }
+    for (; size >= 8; p += 8, size -= 8) {
+        wide = _mm_crc32_u64(wide, read8(p));
+    }
+    crc = static_cast<uint32_t>(wide);
+#endif
+    for (; size >= 4; p += 4, size -= 4) {
+        crc = _mm_crc32_u32(crc, static_cast<uint32_t>(read4(p)));
+    }
+    for (; size > 0; ++p, --size) {
+        crc = _mm_crc32_u8(crc, *p);
+    }
+    return crc;
+}
+#endif
+
+#if defined(MSH_UTILS_NEON) && defined(__ARM_FEATURE_CRC32)
+inline uint32_t crc32cArm(uint32_t crc, const uint8_t* p, size_t size) noexcept {
+    for (; size >= 8; p += 8, size -= 8) {
+        crc = __crc32cd(crc, read8(p));
+    }
+    for (; size > 0; ++p, --size) {
+        crc = __crc32cb(crc, *p);
+    }
+    return crc;
+}
+#endif
+
+}  // namespace detail
+
+/**
+ * @brief 64-bit non-cryptographic hash of a byte range (wyhash)
+ *
+ * Suitable for hash tables and deduplication, not for authentication. Values are stable within a
+ * build for a given byte order, but are not meant to be persisted.
+ *
+ * @param data Bytes to hash, may be null when size is 0
+ * @param size Number of bytes
+ * @param seed Selects an independent hash function
+ */
+inline uint64_t hash64(const void* data, const size_t size, uint64_t seed = 0) noexcept {
+    const auto* p = static_cast<const uint8_t*>(data);
+    seed ^= detail::mix(seed ^ detail::secret[0], detail::secret[1]);
+
+    uint64_t a = 0;
+    uint64_t b = 0;
+    if (size <= 16) {
+        detail::smallInput(p, size, a, b);
+    } else {
+        size_t remaining = size;
+        if (remaining > 48) {
+            uint64_t see1 = seed;
+            uint64_t see2 = seed;
+            do {
+                detail::stripe(p, seed, see1, see2);
+                p += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= see1 ^ see2;
+        }
+        detail::tail(p, remaining, seed, a, b);
+    }
+    return detail::finish(a, b, seed, size);
+}
+
+/**
+ * @brief Incremental hash64: feeding the same bytes in any split yields the same value
+ *
+ * @code
+ * hash::Hasher64 hasher;
+ * while (reader.read(chunk, hasher)) { ... }
+ * const auto digest = hasher.value();
+ * @endcode
+ */
+class Hasher64 {
+  public:
+    explicit Hasher64(const uint64_t seed = 0) noexcept {
+        reset(seed);
+    }
+
+    void reset(const uint64_t seed = 0) noexcept {
+        m_seed = seed ^ detail::mix(seed ^ detail::secret[0], detail::secret[1]);
+        m_see1 = m_seed;
+        m_see2 = m_seed;
+        m_size = 0;
+        m_pending = 0;
+    }
+
+    void update(const void* data, size_t size) noexcept {
+        const auto* p = static_cast<const uint8_t*>(data);
+        m_size += size;
+
+        // Stripes are only consumed once a byte follows them, the last one belongs to the tail
+        if (m_pending != 0) {
+            const size_t take = std::min(size, stripe_size - m_pending);
+            std::memcpy(m_buffer + history + m_pending, p, take);
+            m_pending += take;
+            p += take;
+            size -= take;
+            if (size == 0) {
+                return;
+            }
+            detail::stripe(m_buffer + history, m_seed, m_see1, m_see2);
+            std::memcpy(m_buffer, m_buffer + stripe_size, history);
+            m_pending = 0;
+        }
+        if (size > stripe_size) {
+            do {
+                detail::stripe(p, m_seed, m_see1, m_see2);
+                p += stripe_size;
+                size -= stripe_size;
+            } while (size > stripe_size);
+            std::memcpy(m_buffer, p - history, history);
+        }
+        std::memcpy(m_buffer + history, p, size);
+        m_pending = size;
+    }
+
+    template <typename Bytes>
+    void update(const Bytes& bytes) noexcept {
+        update(bytes.data(), bytes.size());
+    }
+
+    /**
+     * @brief Hash of all bytes so far, equal to hash64 over their concatenation
+     */
+    uint64_t value() const noexcept {
+        const uint8_t* p = m_buffer + history;
+        uint64_t seed = m_seed;
+        uint64_t a = 0;
+        uint64_t b = 0;
+        if (m_size <= 16) {
+            detail::smallInput(p, m_size, a, b);
+        } else {
+            if (m_size > stripe_size) {
+                seed ^= m_see1 ^ m_see2;
+            }
+            detail::tail(p, m_pending, seed, a, b);
+        }
+        return detail::finish(a, b, seed, m_size);
+    }
+
+  private:
+    static constexpr size_t stripe_size = 48;
+    // Bytes kept before the pending tail, which may read up to 16 bytes back
+    static constexpr size_t history = 16;
+
+    uint64_t m_seed;
+    uint64_t m_see1;
+    uint64_t m_see2;
+    uint64_t m_size;
+    size_t m_pending;
+    uint8_t m_buffer[history + stripe_size] = {};
+};
+
+/**
+ * @brief CRC-32C (Castagnoli) of a byte range, as used by iSCSI, ext4 and SCTP
+ *
+ * Uses the SSE4.2 or ARMv8 CRC instructions when available and a slicing-by-8 table otherwise.
+ *
+ * @param data Bytes to checksum, may be null when size is 0
+ * @param size Number of bytes
+ * @param crc CRC of the preceding bytes, to checksum data in pieces
+ */
+inline uint32_t crc32c(const void* data, const size_t size, const uint32_t crc = 0) noexcept {
+    const auto* p = static_cast<const uint8_t*>(data);
+#if defined(MSH_UTILS_X86)
+    if (cpu::features().sse42) {
+        return ~detail::crc32cSse42(~crc, p, size);
+    }
+#elif defined(MSH_UTILS_NEON) && defined(__ARM_FEATURE_CRC32)
+    return ~detail::crc32cArm(~crc, p, size);
+#endif
+    return ~detail::crc32cScalar(~crc, p, size);
+}
+
+/**
+ * @brief Incremental crc32c, for checksumming a stream as it is read or written
+ */
+class Crc32c {
+  public:
+    void reset() noexcept {
+        m_crc = 0;
+    }
+
+    void update(const void* data, const size_t size) noexcept {
+        m_crc = crc32c(data, size, m_crc);
+    }
+
+    template <typename Bytes>
+    void update(const Bytes& bytes) noexcept {
+        update(bytes.data(), bytes.size());
+    }
+
+    uint32_t value() const noexcept {
+        return m_crc;
+    }
+
+  private:
+    uint32_t m_crc = 0;
+};
+
+}  // namespace hash
+
+}  // namespace msh::utils
+
+#endif  // MSH_UTILS_HASH_HPP
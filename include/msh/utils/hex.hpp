@@ -0,0 +1,293 @@
+#ifndef MSH_UTILS_HEX_HPP
+#define MSH_UTILS_HEX_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "cpu_features.hpp"
+
+namespace msh::utils {
+
+namespace hex {
+
+enum class Case { Upper, Lower };
+
+namespace detail {
+
+inline constexpr char upper_digits[] = "0123456789ABCDEF";
+inline constexpr char lower_digits[] = "0123456789abcdef";
+
+inline constexpr uint8_t invalid_nibble = 0xFF;
+
+inline constexpr std::array<uint8_t, 256> nibble_table = [] {
+    std::array<uint8_t, 256> table{};
+    for (auto& entry : table) {
+        entry = invalid_nibble;
+    }
+    for (int c = '0'; c <= '9'; ++c) {
+        table[c] = static_cast<uint8_t>(c - '0');
+    }
+    for (int c = 'A'; c <= 'F'; ++c) {
+        table[c] = static_cast<uint8_t>(c - 'A' + 10);
+        table[c + ('a' - 'A')] = static_cast<uint8_t>(c - 'A' + 10);
+    }
+    return table;
+}();
+
+inline void encodeScalar(const uint8_t* src, const size_t size, char* dst, const Case letter_case) {
+    const char* digits = letter_case == Case::Upper ? upper_digits : lower_digits;
+    for (size_t i = 0; i < size; ++i) {
+        dst[2 * i] = digits[src[i] >> 4];
+        dst[2 * i + 1] = digits[src[i] & 0x0F];
+    }
+}
+
+// Returns the number of bytes decoded before the first invalid pair
+inline size_t decodeScalar(const char* src, const size_t size, uint8_t* dst) {
+    for (size_t i = 0; i < size; ++i) {
+        const uint8_t high = nibble_table[static_cast<uint8_t>(src[2 * i])];
+        const uint8_t low = nibble_table[static_cast<uint8_t>(src[2 * i + 1])];
+        if ((high | low) > 0x0F) {
+            return i;
+        }
+        dst[i] = static_cast<uint8_t>((high << 4) | low);
+    }
+    return size;
+}
+
+// SIMD kernels process whole blocks only and return the number of bytes they handled; the caller
+// finishes the tail with the next narrower kernel.
+
+#if defined(MSH_UTILS_SSE2)
+inline __m128i nibbleToAsciiSse2(const __m128i nibble, const __m128i letter_offset) {
+    const __m128i is_letter = _mm_cmpgt_epi8(nibble, _mm_set1_epi8(9));
+    return _mm_add_epi8(_mm_add_epi8(nibble, _mm_set1_epi8('0')),
+                        _mm_and_si128(is_letter, letter_offset));
+}
+
+inline size_t encodeSse2(const uint8_t* src, const size_t size, char* dst, const Case letter_case) {
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    const __m128i letter_offset =
+        _mm_set1_epi8(static_cast<char>((letter_case == Case::Upper ? 'A' : 'a') - '0' - 10));
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i high = nibbleToAsciiSse2(_mm_and_si128(_mm_srli_epi16(bytes, 4), mask),
+                                               letter_offset);
+        const __m128i low = nibbleToAsciiSse2(_mm_and_si128(bytes, mask), letter_offset);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i + 16),
+                         _mm_unpackhi_epi8(high, low));
+    }
+    return i;
+}
+
+inline __m128i asciiToNibbleSse2(const __m128i chars, __m128i& valid) {
+    const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    // Folding to lowercase leaves digits outside the letter range
+    const __m128i letter =
+        _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+    valid = _mm_and_si128(valid, _mm_or_si128(is_digit, is_letter));
+    return _mm_or_si128(_mm_and_si128(is_digit, digit),
+                        _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+inline __m128i combineNibblesSse2(const __m128i nibbles) {
+    const __m128i high = _mm_and_si128(nibbles, _mm_set1_epi16(0x00FF));
+    const __m128i low = _mm_srli_epi16(nibbles, 8);
+    return _mm_or_si128(_mm_slli_epi16(high, 4), low);
+}
+
+inline size_t decodeSse2(const char* src, const size_t size, uint8_t* dst) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i valid = _mm_set1_epi8(-1);
+        const __m128i first = asciiToNibbleSse2(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i)), valid);
+        const __m128i second = asciiToNibbleSse2(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * i + 16)), valid);
+        if (_mm_movemask_epi8(valid) != 0xFFFF) {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_packus_epi16(combineNibblesSse2(first), combineNibblesSse2(second)));
+    }
+    return i;
+}
+
+MSH_UTILS_TARGET("avx2")
+inline __m256i nibbleToAsciiAvx2(const __m256i nibble, const __m256i letter_offset) {
+    const __m256i is_letter = _mm256_cmpgt_epi8(nibble, _mm256_set1_epi8(9));
+    return _mm256_add_epi8(_mm256_add_epi8(nibble, _mm256_set1_epi8('0')),
+                           _mm256_and_si256(is_letter, letter_offset));
+}
+
+MSH_UTILS_TARGET("avx2")
+inline size_t encodeAvx2(const uint8_t* src, const size_t size, char* dst, const Case letter_case) {
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+    const __m256i letter_offset =
+        _mm256_set1_epi8(static_cast<char>((letter_case == Case::Upper ? 'A' : 'a') - '0' - 10));
+
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i high = nibbleToAsciiAvx2(
+            _mm256_and_si256(_mm256_srli_epi16(bytes, 4), mask), letter_offset);
+        const __m256i low = nibbleToAsciiAvx2(_mm256_and_si256(bytes, mask), letter_offset);
+        // Unpacking works per 128-bit lane, so swap the middle halves back into byte order
+        const __m256i first = _mm256_unpacklo_epi8(high, low);
+        const __m256i second = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i),
+                            _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i + 32),
+                            _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    return i;
+}
+
+MSH_UTILS_TARGET("avx2")
+inline __m256i asciiToNibbleAvx2(const __m256i chars, __m256i& valid) {
+    const __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    const __m256i letter =
+        _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i is_letter =
+        _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+    valid = _mm256_and_si256(valid, _mm256_or_si256(is_digit, is_letter));
+    return _mm256_or_si256(
+        _mm256_and_si256(is_digit, digit),
+        _mm256_and_si256(is_letter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+}
+
+MSH_UTILS_TARGET("avx2")
+inline __m256i combineNibblesAvx2(const __m256i nibbles) {
+    const __m256i high = _mm256_and_si256(nibbles, _mm256_set1_epi16(0x00FF));
+    const __m256i low = _mm256_srli_epi16(nibbles, 8);
+    return _mm256_or_si256(_mm256_slli_epi16(high, 4), low);
+}
+
+MSH_UTILS_TARGET("avx2")
+inline size_t decodeAvx2(const char* src, const size_t size, uint8_t* dst) {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i valid = _mm256_set1_epi8(-1);
+        const __m256i first = asciiToNibbleAvx2(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 2 * i)), valid);
+        const __m256i second = asciiToNibbleAvx2(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 2 * i + 32)), valid);
+        if (_mm256_movemask_epi8(valid) != -1) {
+            break;
+        }
+        // Packing also works per lane, so restore the qword order afterwards
+        const __m256i packed =
+            _mm256_packus_epi16(combineNibblesAvx2(first), combineNibblesAvx2(second));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    return i;
+}
+#endif
+
+#if defined(MSH_UTILS_NEON)
+inline size_t encodeNeon(const uint8_t* src, const size_t size, char* dst, const Case letter_case) {
+    const uint8x16_t digits = vld1q_u8(reinterpret_cast<const uint8_t*>(
+        letter_case == Case::Upper ? upper_digits : lower_digits));
+    const uint8x16_t mask = vdupq_n_u8(0x0F);
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const uint8x16_t bytes = vld1q_u8(src + i);
+        uint8x16x2_t chars;
+        chars.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(bytes, 4));
+        chars.val[1] = vqtbl1q_u8(digits, vandq_u8(bytes, mask));
+        vst2q_u8(reinterpret_cast<uint8_t*>(dst + 2 * i), chars);
+    }
+    return i;
+}
+
+inline uint8x16_t asciiToNibbleNeon(const uint8x16_t chars, uint8x16_t& valid) {
+    const uint8x16_t digit = vsubq_u8(chars, vdupq_n_u8('0'));
+    const uint8x16_t is_digit = vcleq_u8(digit, vdupq_n_u8(9));
+    const uint8x16_t letter = vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    const uint8x16_t is_letter = vcleq_u8(letter, vdupq_n_u8(5));
+    valid = vandq_u8(valid, vorrq_u8(is_digit, is_letter));
+    return vorrq_u8(vandq_u8(is_digit, digit),
+                    vandq_u8(is_letter, vaddq_u8(letter, vdupq_n_u8(10))));
+}
+
+inline size_t decodeNeon(const char* src, const size_t size, uint8_t* dst) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        // De-interleaves high nibble characters into val[0] and low ones into val[1]
+        const uint8x16x2_t chars = vld2q_u8(reinterpret_cast<const uint8_t*>(src + 2 * i));
+        uint8x16_t valid = vdupq_n_u8(0xFF);
+        const uint8x16_t high = asciiToNibbleNeon(chars.val[0], valid);
+        const uint8x16_t low = asciiToNibbleNeon(chars.val[1], valid);
+        if (vminvq_u8(valid) != 0xFF) {
+            break;
+        }
+        vst1q_u8(dst + i, vorrq_u8(vshlq_n_u8(high, 4), low));
+    }
+    return i;
+}
+#endif
+
+}  // namespace detail
+
+/**
+ * @brief Encode bytes as hex digits, two characters per byte
+ * @param src Bytes to encode
+ * @param size Number of bytes to encode
+ * @param dst Output buffer of at least 2 * size characters, not null-terminated
+ * @param letter_case Case of the digits A-F
+ */
+inline void encode(const uint8_t* src,
+                   const size_t size,
+                   char* dst,
+                   const Case letter_case = Case::Upper) {
+    size_t done = 0;
+#if defined(MSH_UTILS_SSE2)
+    if (cpu::features().avx2) {
+        done = detail::encodeAvx2(src, size, dst, letter_case);
+    }
+    done += detail::encodeSse2(src + done, size - done, dst + 2 * done, letter_case);
+#elif defined(MSH_UTILS_NEON)
+    done = detail::encodeNeon(src, size, dst, letter_case);
+#endif
+    detail::encodeScalar(src + done, size - done, dst + 2 * done, letter_case);
+}
+
+/**
+ * @brief Decode hex digits of either case into bytes
+ * @param src Hex characters to decode
+ * @param length Number of characters, must be even
+ * @param dst Output buffer of at least length / 2 bytes
+ * @return true if successful, false on odd length or a non-hex character
+ */
+inline bool decode(const char* src, const size_t length, uint8_t* dst) {
+    if (length % 2 != 0) {
+        return false;
+    }
+
+    const size_t size = length / 2;
+    size_t done = 0;
+#if defined(MSH_UTILS_SSE2)
+    if (cpu::features().avx2) {
+        done = detail::decodeAvx2(src, size, dst);
+    }
+    done += detail::decodeSse2(src + 2 * done, size - done, dst + done);
+#elif defined(MSH_UTILS_NEON)
+    done = detail::decodeNeon(src, size, dst);
+#endif
+    return detail::decodeScalar(src + 2 * done, size - done, dst + done) == size - done;
+}
+
+}  // namespace hex
+
+}  // namespace msh::utils
+
+#endif  // MSH_UTILS_HEX_HPP
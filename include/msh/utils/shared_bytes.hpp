@@ -0,0 +1,232 @@
+#ifndef MSH_UTILS_SHARED_BYTES_HPP
+#define MSH_UTILS_SHARED_BYTES_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "byte_array.hpp"
+#include "byte_view.hpp"
+#include "hash.hpp"
+
+namespace msh::utils {
+
+/**
+ * @brief Immutable, reference-counted byte buffer with O(1) copies and slices
+ *
+ * Copies and slices share one buffer, so handing a payload to several consumers costs a reference
+ * count increment each instead of a copy of the bytes. A ByteArray moved in is adopted without
+ * copying. The bytes are never modified while shared: mutableData() and release() detach into a
+ * private copy unless this is the only reference to the whole buffer.
+ *
+ * Reference counting is thread-safe; as with std::shared_ptr, a single SharedBytes object must not
+ * be modified by several threads at once.
+ */
+class SharedBytes {
+  public:
+    using value_type = uint8_t;
+    using size_type = std::size_t;
+    using const_iterator = const value_type*;
+    using iterator = const_iterator;
+
+    static constexpr size_type npos = ByteView::npos;
+
+    // Constructors
+    SharedBytes() noexcept = default;
+
+    /**
+     * @brief Adopt the buffer of bytes; heap buffers are taken over without copying
+     */
+    explicit SharedBytes(ByteArray&& bytes) : SharedBytes(new Block(std::move(bytes))) {}
+
+    explicit SharedBytes(const ByteView view) : SharedBytes(new Block(ByteArray(view))) {}
+
+    // Copy operations
+    SharedBytes(const SharedBytes& other) noexcept
+        : m_block(other.m_block), m_data(other.m_data), m_size(other.m_size) {
+        if (m_block != nullptr) {
+            m_block->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    SharedBytes& operator=(const SharedBytes& other) noexcept {
+        SharedBytes(other).swap(*this);
+        return *this;
+    }
+
+    // Move operations
+    SharedBytes(SharedBytes&& other) noexcept
+        : m_block(std::exchange(other.m_block, nullptr)),
+          m_data(std::exchange(other.m_data, nullptr)),
+          m_size(std::exchange(other.m_size, 0)) {}
+
+    SharedBytes& operator=(SharedBytes&& other) noexcept {
+        SharedBytes(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    ~SharedBytes() {
+        unref();
+    }
+
+    void swap(SharedBytes& other) noexcept {
+        std::swap(m_block, other.m_block);
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+    }
+
+    // Element access
+    const value_type& at(const size_type pos) const {
+        if (pos >= m_size) {
+            throw std::out_of_range("SharedBytes index out of range");
+        }
+        return m_data[pos];
+    }
+
+    const value_type& operator[](const size_type pos) const noexcept {
+        return m_data[pos];
+    }
+
+    const value_type* data() const noexcept {
+        return m_data;
+    }
+
+    ByteView view() const noexcept {
+        return ByteView(m_data, m_size);
+    }
+    operator ByteView() const noexcept {
+        return view();
+    }
+
+    // Iterators
+    const_iterator begin() const noexcept {
+        return m_data;
+    }
+    const_iterator cbegin() const noexcept {
+        return m_data;
+    }
+
+    const_iterator end() const noexcept {
+        return m_data + m_size;
+    }
+    const_iterator cend() const noexcept {
+        return m_data + m_size;
+    }
+
+    // Capacity
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+    size_type size() const noexcept {
+        return m_size;
+    }
+
+    // Sharing
+    /**
+     * @brief Number of SharedBytes referencing the buffer, 0 for an empty default
+     */
+    long useCount() const noexcept {
+        return m_block != nullptr ? static_cast<long>(m_block->refs.load(std::memory_order_acquire))
+                                  : 0;
+    }
+
+    /**
+     * @brief Slice sharing this buffer, without copying
+     */
+    SharedBytes slice(const size_type pos, const size_type count = npos) const {
+        if (pos > m_size) {
+            throw std::out_of_range("SharedBytes position out of range");
+        }
+        SharedBytes result(*this);
+        result.m_data += pos;
+        result.m_size = std::min(count, m_size - pos);
+        return result;
+    }
+
+    // Modifiers
+    /**
+     * @brief Writable pointer to the bytes, detaching into a private copy first if the buffer is
+     * shared or only partly covered by this slice
+     */
+    value_type* mutableData() {
+        if (!owned()) {
+            SharedBytes(view()).swap(*this);
+        }
+        return m_block->bytes.data();
+    }
+
+    /**
+     * @brief Hand the bytes over as a ByteArray, leaving this empty
+     *
+     * The buffer is moved out when this is its only reference and covers all of it, and copied
+     * otherwise.
+     */
+    ByteArray release() {
+        ByteArray result = owned() ? std::move(m_block->bytes) : ByteArray(view());
+        SharedBytes().swap(*this);
+        return result;
+    }
+
+    // Comparison operators
+    bool operator==(const SharedBytes& other) const noexcept {
+        return view() == other.view();
+    }
+
+    bool operator!=(const SharedBytes& other) const noexcept {
+        return !(*this == other);
+    }
+
+    // Utility functions
+    std::string toHexString(const hex::Case letter_case = hex::Case::Upper) const {
+        return view().toHexString(letter_case);
+    }
+
+    std::string string() const {
+        return view().string();
+    }
+
+  private:
+    struct Block {
+        explicit Block(ByteArray&& adopted) noexcept : bytes(std::move(adopted)) {}
+
+        std::atomic<size_t> refs{1};
+        ByteArray bytes;
+    };
+
+    Block* m_block = nullptr;
+    const value_type* m_data = nullptr;
+    size_type m_size = 0;
+
+    explicit SharedBytes(Block* block) noexcept
+        : m_block(block), m_data(block->bytes.data()), m_size(block->bytes.size()) {}
+
+    // True if nothing else can observe a write through this object
+    bool owned() const noexcept {
+        return m_block != nullptr && m_block->refs.load(std::memory_order_acquire) == 1 &&
+               m_data == m_block->bytes.data() && m_size == m_block->bytes.size();
+    }
+
+    void unref() noexcept {
+        if (m_block != nullptr && m_block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete m_block;
+        }
+    }
+};
+
+}  // namespace msh::utils
+
+namespace std {
+
+template <>
+struct hash<msh::utils::SharedBytes> {
+    size_t operator()(const msh::utils::SharedBytes& bytes) const noexcept {
+        return static_cast<size_t>(msh::utils::hash::hash64(bytes.data(), bytes.size()));
+    }
+};
+
+}  // namespace std
+
+#endif  // MSH_UTILS_SHARED_BYTES_HPP
@@ -0,0 +1,107 @@
+#ifndef MSH_UTILS_Z85_HPP
+#define MSH_UTILS_Z85_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace msh::utils {
+
+/**
+ * @brief Z85, the ZeroMQ base85 encoding (ZeroMQ RFC 32)
+ *
+ * Every 4 bytes become 5 printable characters that need no quoting in JSON, C strings or
+ * shell arguments, 25% overhead against 33% for base64. Input sizes must be multiples of 4.
+ */
+namespace z85 {
+
+namespace detail {
+
+inline constexpr char chars[] =
+    "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ.-:+=^!/*?&<>()[]{}@%$#";
+
+inline constexpr uint8_t invalid_value = 0xFF;
+
+inline constexpr std::array<uint8_t, 256> value_table = [] {
+    std::array<uint8_t, 256> table{};
+    for (auto& entry : table) {
+        entry = invalid_value;
+    }
+    for (int i = 0; i < 85; ++i) {
+        table[static_cast<uint8_t>(chars[i])] = static_cast<uint8_t>(i);
+    }
+    return table;
+}();
+
+}  // namespace detail
+
+constexpr size_t encodedSize(const size_t size) noexcept {
+    return size / 4 * 5;
+}
+
+constexpr size_t decodedSize(const size_t length) noexcept {
+    return length / 5 * 4;
+}
+
+/**
+ * @brief Encode bytes as Z85
+ *
+ * The divisions by 85 are by a constant, which compilers turn into multiplications.
+ *
+ * @param src Bytes to encode
+ * @param size Number of bytes to encode, must be a multiple of 4
+ * @param dst Output buffer of at least encodedSize(size) characters, not null-terminated
+ * @return true if successful, false if size is not a multiple of 4
+ */
+inline bool encode(const uint8_t* src, const size_t size, char* dst) {
+    if (size % 4 != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < size / 4; ++i) {
+        uint32_t value = (static_cast<uint32_t>(src[4 * i]) << 24) |
+                         (static_cast<uint32_t>(src[4 * i + 1]) << 16) |
+                         (static_cast<uint32_t>(src[4 * i + 2]) << 8) | src[4 * i + 3];
+        for (int k = 4; k >= 0; --k) {
+            dst[5 * i + k] = detail::chars[value % 85];
+            value /= 85;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Decode Z85
+ * @param src Characters to decode
+ * @param length Number of characters, must be a multiple of 5
+ * @param dst Output buffer of at least decodedSize(length) bytes
+ * @return true if successful, false on a bad length, a character outside the alphabet or a
+ * group above 2^32 - 1
+ */
+inline bool decode(const char* src, const size_t length, uint8_t* dst) {
+    if (length % 5 != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < length / 5; ++i) {
+        uint64_t value = 0;
+        uint8_t invalid = 0;
+        for (size_t k = 0; k < 5; ++k) {
+            const uint8_t v = detail::value_table[static_cast<uint8_t>(src[5 * i + k])];
+            invalid |= v;
+            value = value * 85 + v;
+        }
+        if (invalid == detail::invalid_value || value > UINT32_MAX) {
+            return false;
+        }
+        dst[4 * i] = static_cast<uint8_t>(value >> 24);
+        dst[4 * i + 1] = static_cast<uint8_t>(value >> 16);
+        dst[4 * i + 2] = static_cast<uint8_t>(value >> 8);
+        dst[4 * i + 3] = static_cast<uint8_t>(value);
+    }
+    return true;
+}
+
+}  // namespace z85
+
+}  // namespace msh::utils
+
+#endif  // MSH_UTILS_Z85_HPP
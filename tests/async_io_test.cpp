@@ -0,0 +1,93 @@
+#include "msh/utils/async_io.hpp"
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace msh::utils;
+
+namespace {
+
+ByteArray makeData(const size_t size, const uint8_t seed) {
+    ByteArray data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(i * 13 + seed);
+    }
+    return data;
+}
+
+}  // namespace
+
+TEST_CASE("file_io: AsyncIO", "[async_io]") {
+    auto temp_dir = std::filesystem::temp_directory_path() / "msh_utils_async_test";
+    std::filesystem::create_directories(temp_dir);
+
+    for (const auto backend :
+         {file_io::AsyncOptions::Backend::Auto, file_io::AsyncOptions::Backend::ThreadPool}) {
+        file_io::AsyncOptions options;
+        options.backend = backend;
+        options.queueDepth = 4;
+        options.threads = 4;
+        file_io::AsyncIO io(options);
+        if (backend == file_io::AsyncOptions::Backend::ThreadPool) {
+            CHECK(io.backend() == file_io::AsyncOptions::Backend::ThreadPool);
+        }
+
+        SECTION("write and read back many files") {
+            const size_t file_count = 50;
+            std::vector<ByteArray> expected;
+            std::vector<std::filesystem::path> paths;
+            std::vector<std::future<bool>> writes;
+            for (size_t i = 0; i < file_count; ++i) {
+                expected.push_back(makeData(i * 1000, static_cast<uint8_t>(i)));
+                paths.push_back(temp_dir / ("file_" + std::to_string(i) + ".bin"));
+            }
+            for (size_t i = 0; i < file_count; ++i) {
+                writes.push_back(io.write(paths[i], expected[i]));
+            }
+            for (auto& write : writes) {
+                CHECK(write.get());
+            }
+
+            std::vector<ByteArray> read_data;
+            auto reads = io.read(paths, read_data);
+            REQUIRE(reads.size() == file_count);
+            for (size_t i = 0; i < file_count; ++i) {
+                CHECK(reads[i].get());
+                CHECK(read_data[i] == expected[i]);
+            }
+        }
+
+        SECTION("large file") {
+            const auto data = makeData(3 * 1024 * 1024 + 7, 42);
+            const auto path = temp_dir / "large.bin";
+            REQUIRE(io.write(path, data).get());
+
+            ByteArray read_data;
+            REQUIRE(io.read(path, read_data).get());
+            CHECK(read_data == data);
+        }
+
+        SECTION("callbacks and wait") {
+            const auto data = makeData(100, 1);
+            std::atomic<int> succeeded{0};
+            for (int i = 0; i < 10; ++i) {
+                io.write(temp_dir / ("callback_" + std::to_string(i) + ".bin"),
+                         data,
+                         [&succeeded](const bool ok) { succeeded += ok ? 1 : 0; });
+            }
+            io.wait();
+            CHECK(succeeded == 10);
+        }
+
+        SECTION("failures") {
+            ByteArray read_data;
+            CHECK_FALSE(io.read(temp_dir / "nonexistent.bin", read_data).get());
+            CHECK_FALSE(io.write(temp_dir / "invalid/path/test.bin", ByteArray{0x01}).get());
+        }
+    }
+
+    std::filesystem::remove_all(temp_dir);
+}
@@ -0,0 +1,105 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "msh/utils/buffer_pool.hpp"
+#include "msh/utils/byte_array.hpp"
+
+using namespace msh::utils;
+
+TEST_CASE("BufferPool: size classes", "[buffer_pool]") {
+    REQUIRE(BufferPool::blockSize(1) == 64);
+    REQUIRE(BufferPool::blockSize(64) == 64);
+    REQUIRE(BufferPool::blockSize(65) == 128);
+    REQUIRE(BufferPool::blockSize(4096) == 4096);
+    REQUIRE(BufferPool::blockSize(BufferPool::max_block_size) == BufferPool::max_block_size);
+    REQUIRE(BufferPool::blockSize(BufferPool::max_block_size + 1) ==
+            BufferPool::max_block_size + 1);
+}
+
+TEST_CASE("BufferPool: steady state reuses buffers", "[buffer_pool]") {
+    auto& pool = BufferPool::instance();
+    pool.trim();
+
+    auto process = [&pool]() {
+        std::vector<ByteArray> packets;
+        for (size_t i = 0; i < 16; ++i) {
+            ByteArray packet(&pool);
+            packet.resize(100 + i * 300, static_cast<uint8_t>(i));
+            packets.push_back(std::move(packet));
+        }
+        for (size_t i = 0; i < packets.size(); ++i) {
+            REQUIRE(packets[i].size() == 100 + i * 300);
+            REQUIRE(packets[i][packets[i].size() - 1] == static_cast<uint8_t>(i));
+        }
+    };
+
+    // The first round warms the cache; later rounds must not reach the upstream allocator
+    process();
+    const auto warm = pool.stats();
+    for (int round = 0; round < 100; ++round) {
+        process();
+    }
+    const auto steady = pool.stats();
+    REQUIRE(steady.upstream == warm.upstream);
+    REQUIRE(steady.reused > warm.reused);
+
+    // Oversized buffers bypass the pool
+    ByteArray huge(&pool);
+    huge.resize(BufferPool::max_block_size + 1);
+    REQUIRE(pool.stats().upstream == steady.upstream + 1);
+}
+
+TEST_CASE("BufferPool: buffers released on other threads circulate", "[buffer_pool]") {
+    auto& pool = BufferPool::instance();
+    pool.trim();
+
+    // A producer allocates, a consumer releases, like a packet pipeline
+    auto run = [&pool](const size_t count) {
+        std::vector<ByteArray> batch;
+        for (size_t i = 0; i < count; ++i) {
+            ByteArray packet(&pool);
+            packet.resize(1500, 0xAB);
+            batch.push_back(std::move(packet));
+        }
+        std::thread consumer([batch = std::move(batch)]() mutable {
+            for (const auto& packet : batch) {
+                REQUIRE(packet.size() == 1500);
+            }
+            batch.clear();
+        });
+        consumer.join();
+    };
+
+    run(256);
+    const auto warm = pool.stats();
+    for (int round = 0; round < 20; ++round) {
+        run(256);
+    }
+    REQUIRE(pool.stats().upstream == warm.upstream);
+}
+
+TEST_CASE("BufferPool: concurrent use", "[buffer_pool]") {
+    auto& pool = BufferPool::instance();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&pool, t]() {
+            std::vector<ByteArray> live;
+            for (int i = 0; i < 2000; ++i) {
+                ByteArray bytes(&pool);
+                bytes.resize(64 + static_cast<size_t>((i * 37 + t) % 8000),
+                             static_cast<uint8_t>(i));
+                live.push_back(std::move(bytes));
+                if (live.size() > 40) {
+                    live.erase(live.begin(), live.begin() + 20);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    pool.trim();
+}
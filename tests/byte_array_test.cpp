@@ -1,7 +1,11 @@
 #include "msh/utils/byte_array.hpp"
 
 #include <catch2/catch_test_macros.hpp>
+#include <map>
+#include <memory_resource>
+#include <stdexcept>
 #include <string>
+#include <system_error>
 
 using namespace msh::utils;
 
@@ -155,6 +159,42 @@ TEST_CASE("ByteArray string operations", "[ByteArray]") {
         CHECK_THROWS_AS(ByteArray::fromHexString("0G"), std::invalid_argument);
     }
 
+    SECTION("toHexString lowercase") {
+        ByteArray arr{0x01, 0xAB, 0xFF};
+        CHECK(arr.toHexString(hex::Case::Lower) == "01abff");
+    }
+
+    SECTION("toHexString into reused buffer") {
+        std::string out = "previous contents that are longer";
+        ByteArray{0xDE, 0xAD}.toHexString(out);
+        CHECK(out == "DEAD");
+        ByteArray{0xBE, 0xEF}.toHexString(out, hex::Case::Lower);
+        CHECK(out == "beef");
+    }
+
+    SECTION("fromHexString mixed case") {
+        CHECK(ByteArray::fromHexString("aBcDeF") == ByteArray{0xAB, 0xCD, 0xEF});
+    }
+
+    SECTION("tryFromHexString") {
+        auto arr = ByteArray::tryFromHexString("01ABFF");
+        REQUIRE(arr.has_value());
+        CHECK(*arr == ByteArray{0x01, 0xAB, 0xFF});
+        CHECK_FALSE(ByteArray::tryFromHexString("0").has_value());
+        CHECK_FALSE(ByteArray::tryFromHexString("0G").has_value());
+        CHECK(ByteArray::tryFromHexString("")->empty());
+    }
+
+    SECTION("fromHexString with error code") {
+        std::error_code ec;
+        CHECK(ByteArray::fromHexString("01AB", ec) == ByteArray{0x01, 0xAB});
+        CHECK_FALSE(ec);
+        CHECK(ByteArray::fromHexString("01A", ec).empty());
+        CHECK(ec == std::errc::invalid_argument);
+        CHECK(ByteArray::fromHexString("01AZ", ec).empty());
+        CHECK(ec == std::errc::invalid_argument);
+    }
+
     SECTION("string conversion") {
         std::string original = "Hello";
         ByteArray arr(original);
@@ -175,4 +215,423 @@ TEST_CASE("ByteArray iterator operations", "[ByteArray]") {
         CHECK(vec[1] == 0x02);
         CHECK(vec[2] == 0x03);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("ByteArray small buffer storage", "[ByteArray]") {
+    ByteArray small(ByteArray::inline_capacity, 0x11);
+    ByteArray large(ByteArray::inline_capacity + 1, 0x22);
+
+    SECTION("Inline capacity") {
+        CHECK(ByteArray().capacity() == ByteArray::inline_capacity);
+        CHECK(small.capacity() == ByteArray::inline_capacity);
+        CHECK(large.capacity() > ByteArray::inline_capacity);
+    }
+
+    SECTION("Growing past the inline buffer keeps contents") {
+        ByteArray arr{0x01, 0x02, 0x03};
+        for (uint8_t i = 0; i < 100; ++i) {
+            arr.insert(arr.end(), i);
+        }
+        CHECK(arr.size() == 103);
+        CHECK(arr[0] == 0x01);
+        CHECK(arr[2] == 0x03);
+        CHECK(arr[102] == 99);
+    }
+
+    SECTION("Copy small and large") {
+        ByteArray small_copy(small);
+        ByteArray large_copy(large);
+        CHECK(small_copy == small);
+        CHECK(large_copy == large);
+        CHECK(large_copy.data() != large.data());
+
+        small_copy = large;
+        CHECK(small_copy == large);
+        large_copy = small;
+        CHECK(large_copy == small);
+    }
+
+    SECTION("Move small and large") {
+        const auto* large_data = large.data();
+        ByteArray moved_large(std::move(large));
+        CHECK(moved_large.data() == large_data);
+        CHECK(moved_large.size() == ByteArray::inline_capacity + 1);
+        CHECK(large.empty());
+
+        ByteArray moved_small;
+        moved_small = std::move(small);
+        CHECK(moved_small.size() == ByteArray::inline_capacity);
+        CHECK(moved_small[0] == 0x11);
+        CHECK(small.empty());
+
+        moved_small = std::move(moved_large);
+        CHECK(moved_small.size() == ByteArray::inline_capacity + 1);
+        CHECK(moved_small[0] == 0x22);
+    }
+
+    SECTION("Insert in the middle") {
+        ByteArray arr{0x01, 0x04};
+        uint8_t data[] = {0x02, 0x03};
+        auto it = arr.insert(arr.begin() + 1, data, data + 2);
+        CHECK(*it == 0x02);
+        CHECK(arr == ByteArray{0x01, 0x02, 0x03, 0x04});
+
+        arr.insert(arr.begin(), 40, 0xFF);
+        CHECK(arr.size() == 44);
+        CHECK(arr[39] == 0xFF);
+        CHECK(arr[40] == 0x01);
+        CHECK(arr[43] == 0x04);
+    }
+
+    SECTION("Append to itself") {
+        ByteArray arr(20, 0x33);
+        arr.append(arr);
+        CHECK(arr == ByteArray(40, 0x33));
+        arr.append(arr);
+        CHECK(arr == ByteArray(80, 0x33));
+    }
+
+    SECTION("Back and at on empty array") {
+        ByteArray arr;
+        CHECK_THROWS_AS(arr.back(), std::out_of_range);
+        CHECK_THROWS_AS(arr.at(0), std::out_of_range);
+    }
+}
+
+TEST_CASE("ByteArray hex round trip across block sizes", "[ByteArray]") {
+    static const char digits[] = "0123456789ABCDEF";
+
+    for (size_t size : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000}) {
+        ByteArray arr(size);
+        std::string expected;
+        for (size_t i = 0; i < size; ++i) {
+            arr[i] = static_cast<uint8_t>(i * 37 + 11);
+            expected.push_back(digits[arr[i] >> 4]);
+            expected.push_back(digits[arr[i] & 0x0F]);
+        }
+
+        const std::string encoded = arr.toHexString();
+        CHECK(encoded == expected);
+        CHECK(ByteArray::fromHexString(encoded) == arr);
+        CHECK(ByteArray::fromHexString(arr.toHexString(hex::Case::Lower)) == arr);
+    }
+
+    SECTION("Invalid character at any position") {
+        const std::string valid = ByteArray(100, 0x5A).toHexString();
+        for (size_t pos : {0, 1, 30, 31, 32, 63, 64, 127, 150, 199}) {
+            std::string invalid = valid;
+            invalid[pos] = 'g';
+            CHECK_FALSE(ByteArray::tryFromHexString(invalid).has_value());
+            invalid[pos] = static_cast<char>(0xC6);
+            CHECK_FALSE(ByteArray::tryFromHexString(invalid).has_value());
+        }
+    }
+}
+
+TEST_CASE("ByteArray base64, base32 and Z85 decoding", "[ByteArray]") {
+    SECTION("fromBase64String") {
+        CHECK(ByteArray::fromBase64String("Zm9vYmE=") == ByteArray("fooba"));
+        CHECK(ByteArray::fromBase64String("Zm9vYmE") == ByteArray("fooba"));
+        CHECK(ByteArray::fromBase64String("Zg==") == ByteArray("f"));
+        CHECK(ByteArray::fromBase64String("Zg") == ByteArray("f"));
+        CHECK(ByteArray::fromBase64String("").empty());
+        CHECK(ByteArray::fromBase64String("-_-_", base64::Alphabet::Url) ==
+              ByteArray{0xFB, 0xFF, 0xBF});
+
+        CHECK_THROWS_AS(ByteArray::fromBase64String("-_-_"), std::invalid_argument);
+        CHECK_THROWS_AS(ByteArray::fromBase64String("+/+/", base64::Alphabet::Url),
+                        std::invalid_argument);
+    }
+
+    SECTION("Malformed base64") {
+        for (const char* text : {"Z", "Zg=", "Zg=A", "Z===", "====", "Zm9v Zg==", "Zh==", "Zm9=",
+                                 "Zg==Zg==", "Zm9vYm\n"}) {
+            CAPTURE(text);
+            CHECK_FALSE(ByteArray::tryFromBase64String(text).has_value());
+        }
+    }
+
+    SECTION("fromBase64String with error code") {
+        std::error_code ec;
+        CHECK(ByteArray::fromBase64String("Zm9v", ec) == ByteArray("foo"));
+        CHECK_FALSE(ec);
+        CHECK(ByteArray::fromBase64String("Zm8", ec) == ByteArray("fo"));
+        CHECK_FALSE(ec);
+        CHECK(ByteArray::fromBase64String("Zm9*", ec).empty());
+        CHECK(ec == std::errc::invalid_argument);
+    }
+
+    SECTION("fromBase32String") {
+        CHECK(ByteArray::fromBase32String("MZXW6YQ=") == ByteArray("foob"));
+        CHECK(ByteArray::fromBase32String("MZXW6YQ") == ByteArray("foob"));
+        CHECK(ByteArray::fromBase32String("MZXW6YTBOI======") == ByteArray("foobar"));
+        CHECK(ByteArray::fromBase32String("").empty());
+
+        for (const char* text : {"M", "MZX", "MZXW6Y", "mzxw6yq=", "MY=====", "MZ======",
+                                 "MZXW6YQ==", "MY======MY======", "MZXW1YQ="}) {
+            CAPTURE(text);
+            CHECK_FALSE(ByteArray::tryFromBase32String(text).has_value());
+        }
+        CHECK_THROWS_AS(ByteArray::fromBase32String("M"), std::invalid_argument);
+
+        std::error_code ec;
+        CHECK(ByteArray::fromBase32String("M", ec).empty());
+        CHECK(ec == std::errc::invalid_argument);
+    }
+
+    SECTION("fromZ85String") {
+        CHECK(ByteArray::fromZ85String("HelloWorld") ==
+              ByteArray{0x86, 0x4F, 0xD2, 0x6F, 0xB5, 0x59, 0xF7, 0x5B});
+        // The largest group is %nSc0, above it decodes past 32 bits
+        CHECK(ByteArray::fromZ85String("%nSc0") == ByteArray{0xFF, 0xFF, 0xFF, 0xFF});
+        CHECK_FALSE(ByteArray::tryFromZ85String("%nSc1").has_value());
+        CHECK_FALSE(ByteArray::tryFromZ85String("Hello World").has_value());
+        CHECK_FALSE(ByteArray::tryFromZ85String("Hello\"orld").has_value());
+        CHECK_THROWS_AS(ByteArray::fromZ85String("Hell"), std::invalid_argument);
+
+        std::error_code ec;
+        CHECK(ByteArray::fromZ85String("Hell", ec).empty());
+        CHECK(ec == std::errc::invalid_argument);
+    }
+}
+
+TEST_CASE("ByteArray base64 round trip across block sizes", "[ByteArray]") {
+    static const char chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    for (size_t size : {0, 1, 2, 3, 11, 12, 13, 15, 16, 17, 23, 24, 27, 28, 29, 47, 48, 49, 64,
+                        100, 1000}) {
+        CAPTURE(size);
+        ByteArray arr(size);
+        for (size_t i = 0; i < size; ++i) {
+            arr[i] = static_cast<uint8_t>(i * 37 + 11);
+        }
+
+        // Reference encoding, one bit at a time
+        std::string expected;
+        for (size_t bit = 0; bit < size * 8; bit += 6) {
+            unsigned value = 0;
+            for (size_t k = bit; k < bit + 6; ++k) {
+                const unsigned set = k < size * 8 ? (arr[k / 8] >> (7 - k % 8)) & 1 : 0;
+                value = (value << 1) | set;
+            }
+            expected.push_back(chars[value]);
+        }
+        while (expected.size() % 4 != 0) {
+            expected.push_back('=');
+        }
+
+        const std::string encoded = arr.toBase64String();
+        CHECK(encoded == expected);
+        CHECK(ByteArray::fromBase64String(encoded) == arr);
+        CHECK(ByteArray::fromBase64String(arr.toBase64String(base64::Alphabet::Url, false),
+                                          base64::Alphabet::Url) == arr);
+        CHECK(ByteArray::fromBase32String(arr.toBase32String()) == arr);
+        if (size % 4 == 0) {
+            CHECK(ByteArray::fromZ85String(arr.toZ85String()) == arr);
+        }
+    }
+
+    SECTION("Invalid character at any position") {
+        const std::string valid = ByteArray(150, 0x5A).toBase64String();
+        for (size_t pos : {0, 1, 15, 16, 31, 32, 63, 64, 127, 150, 199}) {
+            std::string invalid = valid;
+            invalid[pos] = '*';
+            CHECK_FALSE(ByteArray::tryFromBase64String(invalid).has_value());
+            invalid[pos] = static_cast<char>(0xC6);
+            CHECK_FALSE(ByteArray::tryFromBase64String(invalid).has_value());
+            invalid[pos] = '-';
+            CHECK_FALSE(ByteArray::tryFromBase64String(invalid).has_value());
+        }
+    }
+}
+
+namespace {
+
+// Counts the allocations it forwards to the new/delete resource
+class CountingResource : public std::pmr::memory_resource {
+  public:
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t outstanding = 0;
+
+  private:
+    void* do_allocate(const size_t bytes, const size_t alignment) override {
+        ++allocations;
+        outstanding += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, const size_t bytes, const size_t alignment) override {
+        ++deallocations;
+        outstanding -= bytes;
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+}  // namespace
+
+TEST_CASE("ByteArray memory resource", "[ByteArray]") {
+    CountingResource counting;
+    const ByteArray large(100, 0x42);
+
+    SECTION("heap buffers come from the resource") {
+        {
+            ByteArray bytes(&counting);
+            REQUIRE(bytes.resource() == &counting);
+            bytes.append(ByteView(std::string_view("short")));
+            REQUIRE(counting.allocations == 0);
+            bytes.append(large);
+            REQUIRE(counting.allocations == 1);
+            REQUIRE(bytes.size() == 105);
+        }
+        REQUIRE(counting.deallocations == 1);
+        REQUIRE(counting.outstanding == 0);
+    }
+
+    SECTION("zero is a size, not a null resource") {
+        const ByteArray zero(0);
+        REQUIRE(zero.empty());
+        REQUIRE(zero.resource() == std::pmr::get_default_resource());
+
+        const ByteArray with_allocator{ByteArray::allocator_type(&counting)};
+        REQUIRE(with_allocator.get_allocator().resource() == &counting);
+    }
+
+    SECTION("copies use the default resource, moves keep theirs") {
+        ByteArray source(large.data(), large.size(), &counting);
+        const ByteArray copy(source);
+        REQUIRE(copy.resource() == std::pmr::get_default_resource());
+        REQUIRE(copy == source);
+
+        const ByteArray copy_into(source, &counting);
+        REQUIRE(copy_into.resource() == &counting);
+        REQUIRE(counting.allocations == 2);
+
+        ByteArray moved(std::move(source));
+        REQUIRE(moved.resource() == &counting);
+        REQUIRE(moved == large);
+        REQUIRE(counting.allocations == 2);
+    }
+
+    SECTION("move assignment across resources copies") {
+        ByteArray target;
+        {
+            ByteArray source(large, &counting);
+            target = std::move(source);
+            REQUIRE(source.empty());
+        }
+        REQUIRE(target.resource() == std::pmr::get_default_resource());
+        REQUIRE(target == large);
+        REQUIRE(counting.outstanding == 0);
+
+        ByteArray same(&counting);
+        ByteArray other(large, &counting);
+        same = std::move(other);
+        REQUIRE(same == large);
+        REQUIRE(counting.allocations == 2);
+    }
+
+    SECTION("arena resource") {
+        std::byte buffer[1024];
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), &counting);
+        ByteArray bytes(large, &arena);
+        bytes.resize(400);
+        REQUIRE(bytes[99] == 0x42);
+        REQUIRE(counting.allocations == 0);
+    }
+}
+
+TEST_CASE("ByteArray uninitialized growth", "[ByteArray]") {
+    SECTION("resize_for_overwrite keeps existing bytes") {
+        ByteArray bytes = {1, 2, 3};
+        bytes.resize_for_overwrite(100);
+        REQUIRE(bytes.size() == 100);
+        REQUIRE(bytes.capacity() >= 100);
+        REQUIRE(bytes[0] == 1);
+        REQUIRE(bytes[2] == 3);
+
+        bytes.resize_for_overwrite(2);
+        REQUIRE(bytes == ByteArray({1, 2}));
+    }
+
+    SECTION("append_with commits what the writer reports") {
+        ByteArray bytes = {0xAA};
+        const auto written = bytes.append_with(64, [](uint8_t* tail, const size_t max_n) {
+            REQUIRE(max_n == 64);
+            for (size_t i = 0; i < 10; ++i) {
+                tail[i] = static_cast<uint8_t>(i);
+            }
+            return size_t{10};
+        });
+        REQUIRE(written == 10);
+        REQUIRE(bytes.size() == 11);
+        REQUIRE(bytes.capacity() >= 65);
+        REQUIRE(bytes[0] == 0xAA);
+        REQUIRE(bytes[10] == 9);
+
+        // Reports beyond the space given are clamped
+        bytes.append_with(4, [](uint8_t*, size_t) { return size_t{100}; });
+        REQUIRE(bytes.size() == 15);
+
+        bytes.append_with(1000, [](uint8_t*, size_t) { return size_t{0}; });
+        REQUIRE(bytes.size() == 15);
+    }
+
+    SECTION("a throwing writer leaves the size unchanged") {
+        ByteArray bytes = {1, 2};
+        REQUIRE_THROWS_AS(bytes.append_with(8,
+                                            [](uint8_t*, size_t) -> size_t {
+                                                throw std::runtime_error("writer failed");
+                                            }),
+                          std::runtime_error);
+        REQUIRE(bytes == ByteArray({1, 2}));
+    }
+}
+
+TEST_CASE("ByteArray search and ordering", "[ByteArray]") {
+    const ByteArray bytes = {'k', '=', 'v', ';', 'k', '2', '=', 'v', '2'};
+
+    SECTION("Search forwards to the view") {
+        CHECK(bytes.find('=') == 1);
+        CHECK(bytes.find(ByteArray{'k', '2'}) == 4);
+        CHECK(bytes.rfind('=') == 6);
+        CHECK(bytes.rfind(ByteArray{'v'}) == 7);
+        CHECK(bytes.find_any(ByteArray{';', '='}, 2) == 3);
+        CHECK(bytes.contains(ByteArray{'v', ';'}));
+        CHECK(bytes.starts_with(ByteArray{'k', '='}));
+        CHECK(bytes.ends_with(ByteArray{'v', '2'}));
+        CHECK(bytes.compare(bytes) == 0);
+
+        const auto pairs = bytes.split(';');
+        REQUIRE(pairs.size() == 2);
+        CHECK(pairs[1] == ByteArray({'k', '2', '=', 'v', '2'}));
+        CHECK(bytes.split(ByteArray{'=', 'v'}).size() == 3);
+    }
+
+    SECTION("Ordering is lexicographic by unsigned byte") {
+        const ByteArray low = {0x01, 0xFF};
+        const ByteArray high = {0x80};
+        const ByteArray prefix = {0x01};
+        CHECK(low < high);
+        CHECK(prefix < low);
+        CHECK(high > low);
+        CHECK(low <= low);
+        CHECK(high >= prefix);
+        CHECK_FALSE(high < high);
+    }
+
+    SECTION("Ordered map keys with heterogeneous lookup") {
+        std::map<ByteArray, int, std::less<>> map;
+        map[ByteArray{0x02}] = 2;
+        map[ByteArray{0x01, 0x00}] = 1;
+        map[ByteArray{0x01}] = 0;
+        CHECK(map.begin()->second == 0);
+        const uint8_t key[] = {0x01, 0x00};
+        const auto it = map.find(ByteView(key, sizeof(key)));
+        REQUIRE(it != map.end());
+        CHECK(it->second == 1);
+    }
+}
@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "msh/utils/byte_array.hpp"
+#include "msh/utils/byte_chain.hpp"
+#include "msh/utils/shared_bytes.hpp"
+
+using namespace msh::utils;
+
+TEST_CASE("ByteChain: assembly", "[ByteChain]") {
+    SECTION("Empty chain") {
+        ByteChain chain;
+        REQUIRE(chain.empty());
+        REQUIRE(chain.size() == 0);
+        REQUIRE(chain.segmentCount() == 0);
+        REQUIRE(chain.views().empty());
+        REQUIRE(chain.flatten().empty());
+    }
+
+    SECTION("Header and trailer around a body without copying it") {
+        ByteArray body(100000, 0xAB);
+        const uint8_t* body_data = body.data();
+        const ByteArray header = {0x01, 0x02};
+        const ByteArray trailer = {0xFF};
+
+        ByteChain chain(std::move(body));
+        chain.prependRef(header);
+        chain.appendRef(trailer);
+
+        REQUIRE(chain.size() == 100003);
+        REQUIRE(chain.segmentCount() == 3);
+
+        const auto views = chain.views();
+        REQUIRE(views.size() == 3);
+        REQUIRE(views[0].data() == header.data());
+        REQUIRE(views[1].data() == body_data);
+        REQUIRE(views[2] == trailer.view());
+
+        const ByteArray flat = chain.flatten();
+        REQUIRE(flat.size() == 100003);
+        REQUIRE(flat[0] == 0x01);
+        REQUIRE(flat[2] == 0xAB);
+        REQUIRE(flat[100002] == 0xFF);
+    }
+
+    SECTION("Shared segments keep the buffer alive") {
+        SharedBytes payload(ByteArray(1000, 7));
+        ByteChain chain;
+        chain.append(payload.slice(10, 20));
+        chain.prepend(ByteArray({1}));
+        REQUIRE(payload.useCount() == 2);
+        payload = SharedBytes();
+        REQUIRE(chain.size() == 21);
+        REQUIRE(chain.flatten()[20] == 7);
+    }
+
+    SECTION("Empty segments are skipped") {
+        ByteChain chain;
+        chain.append(ByteArray());
+        chain.appendRef(ByteView());
+        chain.prependCopy(ByteView());
+        chain.append(SharedBytes());
+        REQUIRE(chain.segmentCount() == 0);
+    }
+}
+
+TEST_CASE("ByteChain: small copies are coalesced", "[ByteChain]") {
+    ByteChain chain;
+    for (uint8_t i = 0; i < 100; ++i) {
+        chain.appendCopy(ByteView(&i, 1));
+    }
+    REQUIRE(chain.segmentCount() == 1);
+    REQUIRE(chain.size() == 100);
+
+    // A large owned body is not reallocated to take a trailer
+    ByteChain framed(ByteArray(ByteChain::coalesce_limit, 0));
+    const uint8_t* body = framed.views()[0].data();
+    const uint8_t crc[4] = {1, 2, 3, 4};
+    framed.appendCopy(ByteView(crc, sizeof(crc)));
+    REQUIRE(framed.segmentCount() == 2);
+    REQUIRE(framed.views()[0].data() == body);
+
+    // Copies after a borrowed segment start a new owned one
+    ByteChain mixed;
+    mixed.appendRef(ByteView(crc, sizeof(crc)));
+    mixed.appendCopy(ByteView(crc, 2));
+    mixed.appendCopy(ByteView(crc + 2, 2));
+    REQUIRE(mixed.segmentCount() == 2);
+    REQUIRE(mixed.flatten() == ByteArray({1, 2, 3, 4, 1, 2, 3, 4}));
+}
+
+TEST_CASE("ByteChain: splicing chains", "[ByteChain]") {
+    ByteChain first;
+    first.append(ByteArray({1, 2}));
+    ByteChain second;
+    second.append(ByteArray({3}));
+    second.append(ByteArray({4, 5}));
+
+    first.append(std::move(second));
+    REQUIRE(second.empty());
+    REQUIRE(second.segmentCount() == 0);
+    REQUIRE(first.segmentCount() == 3);
+    REQUIRE(first.flatten() == ByteArray({1, 2, 3, 4, 5}));
+
+    ByteChain empty;
+    empty.append(std::move(first));
+    REQUIRE(empty.size() == 5);
+
+    // Copies are independent
+    ByteChain copy = empty;
+    copy.appendCopy(ByteView(empty.flatten().data(), 1));
+    REQUIRE(copy.size() == 6);
+    REQUIRE(empty.size() == 5);
+}
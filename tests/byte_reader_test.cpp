@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "msh/utils/byte_array.hpp"
+#include "msh/utils/byte_reader.hpp"
+
+using namespace msh::utils;
+
+namespace {
+
+enum class Kind : uint16_t { Small = 1, Large = 0x0102 };
+
+}  // namespace
+
+TEST_CASE("ByteReader: fixed-width values", "[ByteReader]") {
+    const ByteArray data{0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09};
+
+    SECTION("Little endian by default") {
+        ByteReader reader(data);
+        REQUIRE(reader.read<uint8_t>() == 0x01);
+        REQUIRE(reader.read<uint16_t>() == 0x0302);
+        REQUIRE(reader.read<uint32_t>() == 0x07060504);
+        REQUIRE(reader.position() == 7);
+        REQUIRE(reader.remaining() == 2);
+    }
+
+    SECTION("Big endian") {
+        ByteReader reader(data, endian::Order::Big);
+        REQUIRE(reader.read<uint64_t>() == 0x0102030405060708);
+        reader.seek(0);
+        REQUIRE(reader.read<uint16_t>(endian::Order::Little) == 0x0201);
+        REQUIRE(reader.read<Kind>() == static_cast<Kind>(0x0304));
+    }
+
+    SECTION("Signed and floating point") {
+        const ByteArray encoded{0xFE, 0xFF, 0x00, 0x00, 0xC0, 0x3F, 0x40, 0x09, 0x21, 0xFB,
+                                0x54, 0x44, 0x2D, 0x18};
+        ByteReader reader(encoded);
+        REQUIRE(reader.read<int16_t>() == -2);
+        REQUIRE(reader.read<float>() == 1.5f);
+        REQUIRE(reader.read<double>(endian::Order::Big) == 3.141592653589793);
+        REQUIRE(reader.atEnd());
+    }
+
+    SECTION("Reading past the end throws and keeps the position") {
+        ByteReader reader(data);
+        reader.skip(6);
+        REQUIRE_THROWS_AS(reader.read<uint32_t>(), std::out_of_range);
+        REQUIRE(reader.position() == 6);
+        REQUIRE(reader.read<uint16_t>() == 0x0807);
+        REQUIRE_THROWS_AS(reader.skip(2), std::out_of_range);
+        REQUIRE_THROWS_AS(reader.seek(10), std::out_of_range);
+        REQUIRE(reader.read<uint8_t>() == 0x09);
+        REQUIRE_THROWS_AS(reader.read<uint8_t>(), std::out_of_range);
+    }
+
+    SECTION("Raw bytes") {
+        ByteReader reader(data);
+        const ByteView head = reader.readBytes(3);
+        REQUIRE(head.data() == data.data());
+        REQUIRE(head.size() == 3);
+
+        uint8_t copy[2];
+        reader.readBytes(copy, 2);
+        REQUIRE(copy[0] == 0x04);
+        REQUIRE(copy[1] == 0x05);
+        REQUIRE(reader.unread() == ByteView(data).subview(5));
+        REQUIRE_THROWS_AS(reader.readBytes(5), std::out_of_range);
+    }
+}
+
+TEST_CASE("ByteReader: arrays", "[ByteReader]") {
+    ByteArray data;
+    for (int i = 0; i < 200; ++i) {
+        data.append(ByteView(reinterpret_cast<const uint8_t*>("\x00\x00\x00"), 3));
+        const uint8_t low = static_cast<uint8_t>(i);
+        data.append(&low, 1);
+    }
+
+    for (const auto order : {endian::Order::Little, endian::Order::Big}) {
+        ByteReader reader(data, order);
+        reader.skip(1);
+        std::vector<uint32_t> values(199);
+        reader.readArray(values.data(), values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            // Offset by one byte, every value is read from the bytes 00 00 ii 00
+            const auto expected = static_cast<uint32_t>(i);
+            REQUIRE(values[i] ==
+                    (order == endian::Order::Little ? expected << 16 : expected << 8));
+        }
+        REQUIRE(reader.remaining() == 3);
+        REQUIRE_THROWS_AS(reader.readArray(values.data(), 1), std::out_of_range);
+        REQUIRE(reader.remaining() == 3);
+    }
+}
+
+TEST_CASE("ByteReader: varints", "[ByteReader]") {
+    SECTION("Unsigned") {
+        const ByteArray data{0x00, 0x7F, 0x80, 0x01, 0xE5, 0x8E, 0x26, 0xFF, 0xFF, 0xFF,
+                             0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01};
+        ByteReader reader(data);
+        REQUIRE(reader.readVarint() == 0);
+        REQUIRE(reader.readVarint() == 127);
+        REQUIRE(reader.readVarint() == 128);
+        REQUIRE(reader.readVarint() == 624485);
+        REQUIRE(reader.readVarint() == UINT64_MAX);
+        REQUIRE(reader.atEnd());
+    }
+
+    SECTION("Signed") {
+        const ByteArray data{0x00, 0x7F, 0xC0, 0xBB, 0x78, 0x80, 0x80, 0x80, 0x80, 0x80,
+                             0x80, 0x80, 0x80, 0x80, 0x7F};
+        ByteReader reader(data);
+        REQUIRE(reader.readSignedVarint() == 0);
+        REQUIRE(reader.readSignedVarint() == -1);
+        REQUIRE(reader.readSignedVarint() == -123456);
+        REQUIRE(reader.readSignedVarint() == INT64_MIN);
+        REQUIRE(reader.atEnd());
+    }
+
+    SECTION("Truncated") {
+        const ByteArray data{0x01, 0x80, 0x80};
+        ByteReader reader(data);
+        reader.skip(1);
+        REQUIRE_THROWS_AS(reader.readVarint(), std::out_of_range);
+        REQUIRE(reader.position() == 1);
+        REQUIRE_THROWS_AS(reader.readSignedVarint(), std::out_of_range);
+        REQUIRE(reader.position() == 1);
+    }
+
+    SECTION("Wider than 64 bits") {
+        ByteArray data(9, 0xFF);
+        data.append(ByteArray{0x02});
+        REQUIRE_THROWS_AS(ByteReader(data).readVarint(), std::overflow_error);
+        REQUIRE_THROWS_AS(ByteReader(data).readSignedVarint(), std::overflow_error);
+
+        ByteArray longer(10, 0x80);
+        longer.append(ByteArray{0x00});
+        REQUIRE_THROWS_AS(ByteReader(longer).readVarint(), std::overflow_error);
+    }
+}
@@ -0,0 +1,300 @@
+#include "msh/utils/byte_view.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "msh/utils/byte_array.hpp"
+
+using namespace msh::utils;
+
+TEST_CASE("ByteView basic operations", "[ByteView]") {
+    SECTION("Default constructor") {
+        ByteView view;
+        CHECK(view.empty());
+        CHECK(view.size() == 0);
+        CHECK(view.begin() == view.end());
+    }
+
+    SECTION("Raw data constructor") {
+        uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+        ByteView view(data, sizeof(data));
+        CHECK(view.size() == 4);
+        CHECK(view.data() == data);
+        CHECK(view.front() == 0x01);
+        CHECK(view.back() == 0x04);
+    }
+
+    SECTION("String constructor") {
+        std::string str = "Hello";
+        ByteView view(str);
+        CHECK(view.size() == str.size());
+        CHECK(view.string() == str);
+    }
+
+    SECTION("Implicit conversion from ByteArray") {
+        ByteArray arr{0x01, 0x02, 0x03};
+        ByteView view = arr;
+        CHECK(view.data() == arr.data());
+        CHECK(view.size() == arr.size());
+        CHECK(ByteArray(view) == arr);
+    }
+
+    SECTION("Element access") {
+        ByteArray arr{0x01, 0x02, 0x03};
+        ByteView view = arr;
+        CHECK(view[1] == 0x02);
+        CHECK(view.at(2) == 0x03);
+        CHECK_THROWS_AS(view.at(3), std::out_of_range);
+        CHECK_THROWS_AS(ByteView().front(), std::out_of_range);
+        CHECK_THROWS_AS(ByteView().back(), std::out_of_range);
+    }
+}
+
+TEST_CASE("ByteView slicing", "[ByteView]") {
+    ByteArray arr{0x01, 0x02, 0x03, 0x04, 0x05};
+    ByteView view = arr;
+
+    SECTION("subview") {
+        CHECK(view.subview(1, 2) == ByteArray{0x02, 0x03});
+        CHECK(view.subview(3) == ByteArray{0x04, 0x05});
+        CHECK(view.subview(5).empty());
+        CHECK(view.subview(2, 100).size() == 3);
+        CHECK_THROWS_AS(view.subview(6), std::out_of_range);
+    }
+
+    SECTION("remove_prefix and remove_suffix") {
+        view.remove_prefix(1);
+        view.remove_suffix(2);
+        CHECK(view == ByteArray{0x02, 0x03});
+        CHECK_THROWS_AS(view.remove_prefix(3), std::out_of_range);
+        CHECK_THROWS_AS(view.remove_suffix(3), std::out_of_range);
+    }
+}
+
+TEST_CASE("ByteView search", "[ByteView]") {
+    ByteArray arr{0x01, 0x02, 0x03, 0x01, 0x02, 0x04};
+    ByteView view = arr;
+
+    SECTION("find byte") {
+        CHECK(view.find(0x01) == 0);
+        CHECK(view.find(0x01, 1) == 3);
+        CHECK(view.find(0x05) == ByteView::npos);
+        CHECK(view.find(0x01, 10) == ByteView::npos);
+    }
+
+    SECTION("find pattern") {
+        CHECK(view.find(ByteArray{0x01, 0x02}) == 0);
+        CHECK(view.find(ByteArray{0x01, 0x02}, 1) == 3);
+        CHECK(view.find(ByteArray{0x02, 0x04}) == 4);
+        CHECK(view.find(ByteArray{0x04, 0x01}) == ByteView::npos);
+        CHECK(view.find(ByteView(), 2) == 2);
+        CHECK(view.contains(ByteArray{0x03, 0x01}));
+        CHECK_FALSE(view.contains(0x09));
+    }
+
+    SECTION("rfind") {
+        CHECK(view.rfind(0x01) == 3);
+        CHECK(view.rfind(0x01, 2) == 0);
+        CHECK(view.rfind(0x04, 4) == ByteView::npos);
+        CHECK(view.rfind(0x05) == ByteView::npos);
+        CHECK(ByteView().rfind(0x01) == ByteView::npos);
+        CHECK(view.rfind(ByteArray{0x01, 0x02}) == 3);
+        CHECK(view.rfind(ByteArray{0x01, 0x02}, 2) == 0);
+        CHECK(view.rfind(ByteArray{0x02, 0x04}) == 4);
+        CHECK(view.rfind(ByteArray{0x04, 0x01}) == ByteView::npos);
+        CHECK(view.rfind(ByteView()) == 6);
+        CHECK(view.rfind(ByteView(), 2) == 2);
+    }
+
+    SECTION("find_any") {
+        CHECK(view.find_any(ByteArray{0x04, 0x03}) == 2);
+        CHECK(view.find_any(ByteArray{0x04, 0x03}, 3) == 5);
+        CHECK(view.find_any(ByteArray{0x02}) == 1);
+        CHECK(view.find_any(ByteArray{0x07, 0x08}) == ByteView::npos);
+        CHECK(view.find_any(ByteView()) == ByteView::npos);
+        CHECK(view.find_any(ByteArray{0x01}, 6) == ByteView::npos);
+    }
+
+    SECTION("starts_with and ends_with") {
+        CHECK(view.starts_with(ByteArray{0x01, 0x02, 0x03}));
+        CHECK_FALSE(view.starts_with(ByteArray{0x02}));
+        CHECK(view.ends_with(ByteArray{0x02, 0x04}));
+        CHECK_FALSE(view.ends_with(ByteArray{0x01}));
+        CHECK(view.starts_with(ByteView()));
+    }
+}
+
+TEST_CASE("ByteView search matches a naive scan", "[ByteView]") {
+    std::mt19937 rng(42);
+    // A small alphabet makes matches and near matches frequent
+    ByteArray haystack(3000);
+    for (auto& byte : haystack) {
+        byte = static_cast<uint8_t>(rng() % 4);
+    }
+    const ByteView full = haystack;
+
+    const auto naive_find = [](const ByteView view, const ByteView pattern) {
+        const auto it = std::search(view.begin(), view.end(), pattern.begin(), pattern.end());
+        return it == view.end() && !pattern.empty() ? ByteView::npos
+                                                    : static_cast<size_t>(it - view.begin());
+    };
+
+    for (size_t size : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000, 3000}) {
+        for (size_t offset : {0, 1, 7}) {
+            const ByteView view = full.subview(std::min(offset, full.size() - size), size);
+
+            for (uint8_t value = 0; value < 5; ++value) {
+                size_t expected = ByteView::npos;
+                for (size_t i = 0; i < view.size(); ++i) {
+                    if (view[i] == value) {
+                        expected = i;
+                    }
+                }
+                CHECK(view.rfind(value) == expected);
+            }
+
+            for (size_t length : {2, 3, 5, 8, 40}) {
+                if (length > full.size()) {
+                    continue;
+                }
+                const ByteView pattern =
+                    full.subview(static_cast<size_t>(rng() % (full.size() - length)), length);
+                CHECK(view.find(pattern) == naive_find(view, pattern));
+            }
+
+            const uint8_t set[] = {3, 9, 2};
+            for (size_t set_size = 1; set_size <= 3; ++set_size) {
+                const ByteView members(set + 3 - set_size, set_size);
+                const auto first = std::find_first_of(view.begin(), view.end(),
+                                                      members.begin(), members.end());
+                CHECK(view.find_any(members) ==
+                      (first == view.end() ? ByteView::npos
+                                           : static_cast<size_t>(first - view.begin())));
+            }
+        }
+    }
+
+    // Sets too large for SIMD comparisons fall back to a bitmap
+    ByteArray large_set;
+    for (int value = 100; value < 140; ++value) {
+        large_set.append(ByteArray{static_cast<uint8_t>(value)});
+    }
+    ByteArray text(200, 0);
+    text[150] = 120;
+    CHECK(text.find_any(large_set) == 150);
+}
+
+TEST_CASE("ByteView split", "[ByteView]") {
+    const std::string line = "GET /index.html HTTP/1.1";
+    const ByteView view(line);
+
+    const auto words = view.split(' ');
+    REQUIRE(words.size() == 3);
+    CHECK(words[0].string() == "GET");
+    CHECK(words[1].string() == "/index.html");
+    CHECK(words[2].string() == "HTTP/1.1");
+    CHECK(words[1].data() == view.data() + 4);
+
+    const std::string headers = "a: 1\r\n\r\nb: 2\r\n";
+    const auto lines = ByteView(headers).split(ByteView(std::string_view("\r\n")));
+    REQUIRE(lines.size() == 4);
+    CHECK(lines[0].string() == "a: 1");
+    CHECK(lines[1].empty());
+    CHECK(lines[2].string() == "b: 2");
+    CHECK(lines[3].empty());
+
+    CHECK(ByteView().split(',').size() == 1);
+    CHECK(ByteView(std::string_view(",,")).split(',').size() == 3);
+    CHECK_THROWS_AS(view.split(ByteView()), std::invalid_argument);
+}
+
+TEST_CASE("ByteView constant-time comparison", "[ByteView]") {
+    const ByteArray mac(32, 0x5A);
+    ByteArray other = mac;
+    CHECK(constantTimeEquals(mac, other));
+    other[31] ^= 1;
+    CHECK_FALSE(constantTimeEquals(mac, other));
+    other = mac;
+    other[0] ^= 0x80;
+    CHECK_FALSE(constantTimeEquals(mac, other));
+    CHECK_FALSE(constantTimeEquals(mac, ByteView(mac).subview(1)));
+    CHECK(constantTimeEquals(ByteView(), ByteView()));
+}
+
+TEST_CASE("ByteView comparison operators", "[ByteView]") {
+    ByteArray arr1{0x01, 0x02};
+    ByteArray arr2{0x01, 0x02};
+    ByteArray arr3{0x01, 0x03};
+    ByteArray arr4{0x01};
+
+    CHECK(ByteView(arr1) == ByteView(arr2));
+    CHECK(ByteView(arr1) != arr3);
+    CHECK(ByteView(arr1) < arr3);
+    CHECK(ByteView(arr4) < arr1);
+    CHECK(ByteView(arr3) > arr1);
+    CHECK(ByteView(arr1) <= arr2);
+    CHECK(ByteView(arr1) >= arr2);
+    CHECK(ByteView() < arr4);
+}
+
+TEST_CASE("ByteView string operations", "[ByteView]") {
+    ByteArray arr{0x00, 0x01, 0xAB, 0xFF};
+
+    CHECK(ByteView(arr).toHexString() == "0001ABFF");
+    CHECK(ByteView(arr).subview(2).toHexString() == "ABFF");
+    CHECK(ByteView().toHexString().empty());
+}
+
+TEST_CASE("ByteView base64, base32 and Z85 encoding", "[ByteView]") {
+    // RFC 4648 section 10 test vectors
+    const std::string inputs[] = {"", "f", "fo", "foo", "foob", "fooba", "foobar"};
+    const char* base64_expected[] = {
+        "", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy"};
+    const char* base32_expected[] = {"",
+                                     "MY======",
+                                     "MZXQ====",
+                                     "MZXW6===",
+                                     "MZXW6YQ=",
+                                     "MZXW6YTB",
+                                     "MZXW6YTBOI======"};
+
+    for (size_t i = 0; i < std::size(inputs); ++i) {
+        const ByteArray bytes(inputs[i]);
+        CHECK(ByteView(bytes).toBase64String() == base64_expected[i]);
+        CHECK(ByteView(bytes).toBase32String() == base32_expected[i]);
+
+        std::string unpadded = base64_expected[i];
+        unpadded.erase(unpadded.find_last_not_of('=') + 1);
+        CHECK(ByteView(bytes).toBase64String(base64::Alphabet::Standard, false) == unpadded);
+        unpadded = base32_expected[i];
+        unpadded.erase(unpadded.find_last_not_of('=') + 1);
+        CHECK(ByteView(bytes).toBase32String(false) == unpadded);
+    }
+
+    SECTION("URL-safe alphabet") {
+        const ByteArray bytes{0xFB, 0xFF, 0xBF};
+        CHECK(ByteView(bytes).toBase64String() == "+/+/");
+        CHECK(ByteView(bytes).toBase64String(base64::Alphabet::Url) == "-_-_");
+    }
+
+    SECTION("Z85") {
+        // Test vector from the Z85 specification
+        const ByteArray bytes{0x86, 0x4F, 0xD2, 0x6F, 0xB5, 0x59, 0xF7, 0x5B};
+        CHECK(ByteView(bytes).toZ85String() == "HelloWorld");
+        CHECK(ByteView().toZ85String().empty());
+        CHECK_THROWS_AS(ByteView(bytes).subview(1).toZ85String(), std::invalid_argument);
+    }
+
+    SECTION("Into reused buffer") {
+        std::string out = "previous contents that are longer";
+        ByteView(ByteArray("foo")).toBase64String(out);
+        CHECK(out == "Zm9v");
+        ByteView(ByteArray("f")).toBase32String(out, false);
+        CHECK(out == "MY");
+    }
+}
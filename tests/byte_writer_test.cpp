@@ -0,0 +1,135 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "msh/utils/byte_array.hpp"
+#include "msh/utils/byte_reader.hpp"
+#include "msh/utils/byte_writer.hpp"
+
+using namespace msh::utils;
+
+TEST_CASE("ByteWriter: fixed-width values", "[ByteWriter]") {
+    ByteArray out;
+
+    SECTION("Little and big endian") {
+        ByteWriter writer(out);
+        writer.write(uint8_t{0x01});
+        writer.write(uint16_t{0x0302});
+        writer.write(uint32_t{0x04050607}, endian::Order::Big);
+        writer.write(int16_t{-2});
+        REQUIRE(out == ByteArray{0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xFE, 0xFF});
+        REQUIRE(writer.size() == 9);
+    }
+
+    SECTION("Floating point") {
+        ByteWriter writer(out, endian::Order::Big);
+        writer.write(1.5f);
+        writer.write(3.141592653589793, endian::Order::Little);
+        REQUIRE(out == ByteArray{0x3F, 0xC0, 0x00, 0x00, 0x18, 0x2D, 0x44, 0x54, 0xFB, 0x21,
+                                 0x09, 0x40});
+    }
+
+    SECTION("Appends to existing contents") {
+        out = ByteArray{0xAA};
+        ByteWriter writer(out);
+        writer.writeBytes(ByteArray{0xBB, 0xCC});
+        writer.write(uint16_t{0xEEDD});
+        REQUIRE(out == ByteArray{0xAA, 0xBB, 0xCC, 0xDD, 0xEE});
+    }
+
+    SECTION("Patching a length prefix") {
+        ByteWriter writer(out, endian::Order::Big);
+        writer.write(uint32_t{0});
+        writer.writeBytes(ByteArray{0x11, 0x22, 0x33});
+        writer.writeAt(0, static_cast<uint32_t>(writer.size() - 4));
+        REQUIRE(out == ByteArray{0x00, 0x00, 0x00, 0x03, 0x11, 0x22, 0x33});
+        REQUIRE_THROWS_AS(writer.writeAt(4, uint32_t{0}), std::out_of_range);
+        REQUIRE_THROWS_AS(writer.writeAt(8, uint8_t{0}), std::out_of_range);
+    }
+}
+
+TEST_CASE("ByteWriter: arrays round trip through ByteReader", "[ByteWriter]") {
+    std::vector<uint16_t> u16(77);
+    std::vector<uint64_t> u64(45);
+    std::vector<double> f64(33);
+    for (size_t i = 0; i < u16.size(); ++i) {
+        u16[i] = static_cast<uint16_t>(i * 0x0101 + 7);
+    }
+    for (size_t i = 0; i < u64.size(); ++i) {
+        u64[i] = i * 0x0102030405060708ull;
+    }
+    for (size_t i = 0; i < f64.size(); ++i) {
+        f64[i] = static_cast<double>(i) / 3.0;
+    }
+
+    for (const auto order : {endian::Order::Little, endian::Order::Big}) {
+        ByteArray out;
+        ByteWriter writer(out, order);
+        writer.write(uint8_t{0x5A});
+        writer.writeArray(u16.data(), u16.size());
+        writer.writeArray(u64.data(), u64.size());
+        writer.writeArray(f64.data(), f64.size());
+        REQUIRE(out.size() == 1 + u16.size() * 2 + u64.size() * 8 + f64.size() * 8);
+
+        // Arrays match element-wise writes
+        ByteReader reader(out, order);
+        REQUIRE(reader.read<uint8_t>() == 0x5A);
+        for (const auto value : u16) {
+            REQUIRE(reader.read<uint16_t>() == value);
+        }
+        std::vector<uint64_t> u64_back(u64.size());
+        reader.readArray(u64_back.data(), u64_back.size());
+        REQUIRE(u64_back == u64);
+        std::vector<double> f64_back(f64.size());
+        reader.readArray(f64_back.data(), f64_back.size());
+        REQUIRE(f64_back == f64);
+        REQUIRE(reader.atEnd());
+    }
+}
+
+TEST_CASE("ByteWriter: varints", "[ByteWriter]") {
+    ByteArray out;
+    ByteWriter writer(out);
+
+    SECTION("Encodings") {
+        writer.writeVarint(0);
+        writer.writeVarint(624485);
+        writer.writeSignedVarint(-123456);
+        writer.writeSignedVarint(63);
+        writer.writeSignedVarint(64);
+        REQUIRE(out ==
+                ByteArray{0x00, 0xE5, 0x8E, 0x26, 0xC0, 0xBB, 0x78, 0x3F, 0xC0, 0x00});
+    }
+
+    SECTION("Round trip") {
+        const uint64_t unsigned_values[] = {0, 1, 127, 128, 16383, 16384, UINT32_MAX,
+                                            uint64_t{1} << 63, UINT64_MAX};
+        const int64_t signed_values[] = {0, 1, -1, 63, -64, 64, -65, INT32_MIN, INT64_MAX,
+                                         INT64_MIN};
+        for (const auto value : unsigned_values) {
+            writer.writeVarint(value);
+        }
+        for (const auto value : signed_values) {
+            writer.writeSignedVarint(value);
+        }
+
+        ByteReader reader(out);
+        for (const auto value : unsigned_values) {
+            REQUIRE(reader.readVarint() == value);
+        }
+        for (const auto value : signed_values) {
+            REQUIRE(reader.readSignedVarint() == value);
+        }
+        REQUIRE(reader.atEnd());
+    }
+
+    SECTION("Maximum size") {
+        writer.writeVarint(UINT64_MAX);
+        REQUIRE(out.size() == ByteWriter::max_varint_size);
+        writer.writeSignedVarint(INT64_MIN);
+        REQUIRE(out.size() == 2 * ByteWriter::max_varint_size);
+    }
+}
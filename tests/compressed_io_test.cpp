@@ -0,0 +1,240 @@
+#include "msh/utils/compressed_io.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <random>
+
+using namespace msh::utils;
+
+namespace {
+
+// Compressible data: random runs of a few distinct bytes
+ByteArray sampleData(const size_t size) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dis(0, 7);
+    ByteArray data;
+    data.reserve(size);
+    while (data.size() < size) {
+        const auto value = static_cast<uint8_t>(dis(gen));
+        for (int i = dis(gen); i >= 0 && data.size() < size; --i) {
+            data.append(&value, 1);
+        }
+    }
+    return data;
+}
+
+void truncate(const std::filesystem::path& path) {
+    ByteArray bytes;
+    REQUIRE(file_io::read(path, bytes));
+    REQUIRE(file_io::write(path, bytes.view().subview(0, bytes.size() - 5)));
+}
+
+// Sections shared by the per-codec test cases
+void checkRoundTrips(const file_io::Compression format) {
+    auto temp_dir = std::filesystem::temp_directory_path() / "msh_utils_compressed_test";
+    std::filesystem::create_directories(temp_dir);
+    auto test_file = temp_dir / "data.bin";
+
+    file_io::CompressOptions options;
+    options.format = format;
+
+    if (!file_io::isSupported(format)) {
+        // Fails before creating the file
+        REQUIRE_FALSE(file_io::writeCompressed(test_file, sampleData(100), options));
+        REQUIRE_FALSE(std::filesystem::exists(test_file));
+        std::filesystem::remove_all(temp_dir);
+        return;
+    }
+
+    SECTION("sizes") {
+        for (const size_t size : {size_t{0}, size_t{1}, size_t{1000}, size_t{3} << 20}) {
+            const auto data = sampleData(size);
+            REQUIRE(file_io::writeCompressed(test_file, data, options));
+
+            ByteArray header;
+            REQUIRE(file_io::read(test_file, header));
+            REQUIRE(file_io::detectCompression(header) == format);
+            if (size > 1000) {
+                REQUIRE(header.size() < size / 2);
+            }
+
+            ByteArray read_data;
+            REQUIRE(file_io::readDecompressed(test_file, read_data));
+            REQUIRE(read_data == data);
+        }
+    }
+
+    SECTION("levels and small stream chunks") {
+        const auto data = sampleData(200000);
+        for (const int level : {-1, 0, 9}) {
+            options.level = level;
+            REQUIRE(file_io::writeCompressed(test_file, data, options));
+
+            file_io::StreamOptions stream;
+            stream.bufferSize = 7;
+            ByteArray read_data;
+            REQUIRE(file_io::readDecompressed(test_file, read_data, stream));
+            REQUIRE(read_data == data);
+        }
+    }
+
+    SECTION("atomic replacement") {
+        const auto data = sampleData(50000);
+        REQUIRE(file_io::write(test_file, ByteView("old")));
+        options.write.atomic = true;
+        REQUIRE(file_io::writeCompressed(test_file, data, options));
+
+        ByteArray read_data;
+        REQUIRE(file_io::readDecompressed(test_file, read_data));
+        REQUIRE(read_data == data);
+        REQUIRE(std::distance(std::filesystem::directory_iterator(temp_dir),
+                              std::filesystem::directory_iterator()) == 1);
+    }
+
+    SECTION("concatenated frames") {
+        const auto first = sampleData(3000);
+        const auto second = sampleData(5000);
+        REQUIRE(file_io::writeCompressed(temp_dir / "a", first, options));
+        REQUIRE(file_io::writeCompressed(temp_dir / "b", second, options));
+        ByteArray a;
+        ByteArray b;
+        REQUIRE(file_io::read(temp_dir / "a", a));
+        REQUIRE(file_io::read(temp_dir / "b", b));
+        a.append(b);
+        REQUIRE(file_io::write(test_file, a));
+
+        ByteArray expected = first;
+        expected.append(second);
+        ByteArray read_data;
+        REQUIRE(file_io::readDecompressed(test_file, read_data));
+        REQUIRE(read_data == expected);
+    }
+
+    SECTION("truncated file fails") {
+        REQUIRE(file_io::writeCompressed(test_file, sampleData(100000), options));
+        truncate(test_file);
+
+        ByteArray read_data;
+        REQUIRE_FALSE(file_io::readDecompressed(test_file, read_data));
+        REQUIRE(read_data.empty());
+    }
+
+    SECTION("corrupt data fails") {
+        REQUIRE(file_io::writeCompressed(test_file, sampleData(100000), options));
+        ByteArray bytes;
+        REQUIRE(file_io::read(test_file, bytes));
+        for (size_t i = 20; i < bytes.size(); i += 97) {
+            bytes[i] ^= 0x5A;
+        }
+        REQUIRE(file_io::write(test_file, bytes));
+
+        ByteArray read_data;
+        REQUIRE_FALSE(file_io::readDecompressed(test_file, read_data));
+    }
+
+    std::filesystem::remove_all(temp_dir);
+}
+
+}  // namespace
+
+TEST_CASE("compressed_io: format detection", "[compressed_io]") {
+    const uint8_t zstd[] = {0x28, 0xB5, 0x2F, 0xFD, 0x00};
+    const uint8_t lz4[] = {0x04, 0x22, 0x4D, 0x18, 0x00};
+
+    REQUIRE(file_io::detectCompression(ByteView(zstd, sizeof(zstd))) ==
+            file_io::Compression::Zstd);
+    REQUIRE(file_io::detectCompression(ByteView(lz4, sizeof(lz4))) == file_io::Compression::Lz4);
+    REQUIRE(file_io::detectCompression(ByteView(zstd, 3)) == file_io::Compression::None);
+    REQUIRE(file_io::detectCompression(ByteView()) == file_io::Compression::None);
+    REQUIRE(file_io::detectCompression(ByteView("plain text")) == file_io::Compression::None);
+    REQUIRE(file_io::isSupported(file_io::Compression::None));
+}
+
+TEST_CASE("compressed_io: plain files", "[compressed_io]") {
+    auto temp_dir = std::filesystem::temp_directory_path() / "msh_utils_compressed_test";
+    std::filesystem::create_directories(temp_dir);
+    auto test_file = temp_dir / "plain.bin";
+
+    SECTION("are read unchanged") {
+        const auto data = sampleData(100000);
+        REQUIRE(file_io::write(test_file, data));
+
+        ByteArray read_data;
+        REQUIRE(file_io::readDecompressed(test_file, read_data));
+        REQUIRE(read_data == data);
+    }
+
+    SECTION("shorter than a magic number") {
+        REQUIRE(file_io::write(test_file, ByteView("ab")));
+
+        ByteArray read_data;
+        REQUIRE(file_io::readDecompressed(test_file, read_data));
+        REQUIRE(read_data == ByteArray("ab"));
+
+        REQUIRE(file_io::write(test_file, ByteView()));
+        REQUIRE(file_io::readDecompressed(test_file, read_data));
+        REQUIRE(read_data.empty());
+    }
+
+    SECTION("written without compression") {
+        const auto data = sampleData(1000);
+        file_io::CompressOptions options;
+        options.format = file_io::Compression::None;
+        REQUIRE(file_io::writeCompressed(test_file, data, options));
+
+        ByteArray read_data;
+        REQUIRE(file_io::read(test_file, read_data));
+        REQUIRE(read_data == data);
+    }
+
+    SECTION("missing file") {
+        ByteArray read_data;
+        REQUIRE_FALSE(file_io::readDecompressed(temp_dir / "nonexistent.zst", read_data));
+    }
+
+    std::filesystem::remove_all(temp_dir);
+}
+
+TEST_CASE("compressed_io: zstd round trips", "[compressed_io]") {
+    checkRoundTrips(file_io::Compression::Zstd);
+}
+
+TEST_CASE("compressed_io: LZ4 round trips", "[compressed_io]") {
+    checkRoundTrips(file_io::Compression::Lz4);
+}
+
+#if defined(MSH_UTILS_HAS_ZSTD)
+TEST_CASE("compressed_io: forged content size", "[compressed_io]") {
+    auto temp_dir = std::filesystem::temp_directory_path() / "msh_utils_compressed_test";
+    std::filesystem::create_directories(temp_dir);
+    auto test_file = temp_dir / "forged.zst";
+
+    // Single segment frame declaring 2^62 bytes of content, followed by a bogus block
+    const uint8_t forged[] = {0x28, 0xB5, 0x2F, 0xFD, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00,
+                              0x00, 0x00, 0x40, 0x01, 0x00, 0x00, 0xAA};
+    REQUIRE(file_io::write(test_file, ByteView(forged, sizeof(forged))));
+
+    ByteArray read_data;
+    REQUIRE_FALSE(file_io::readDecompressed(test_file, read_data));
+    REQUIRE(read_data.empty());
+
+    std::filesystem::remove_all(temp_dir);
+}
+
+TEST_CASE("compressed_io: multithreaded zstd", "[compressed_io]") {
+    auto temp_dir = std::filesystem::temp_directory_path() / "msh_utils_compressed_test";
+    std::filesystem::create_directories(temp_dir);
+    auto test_file = temp_dir / "mt.zst";
+
+    const auto data = sampleData(size_t{8} << 20);
+    file_io::CompressOptions options;
+    options.threads = 4;
+    REQUIRE(file_io::writeCompressed(test_file, data, options));
+
+    ByteArray read_data;
+    REQUIRE(file_io::readDecompressed(test_file, read_data));
+    REQUIRE(read_data == data);
+
+    std::filesystem::remove_all(temp_dir);
+}
+#endif
@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <string>
+
+#include "msh/utils/byte_array.hpp"
+#include "msh/utils/byte_view.hpp"
+#include "msh/utils/config_cache.hpp"
+#include "msh/utils/file_io.hpp"
+
+using namespace msh::utils;
+
+namespace {
+
+// Rewrites path with text of the same length and restores its modification time
+void replaceKeepingStamp(const std::filesystem::path& path, const std::string& text) {
+    const auto time = std::filesystem::last_write_time(path);
+    REQUIRE(file_io::write(path, ByteView(text)));
+    std::filesystem::last_write_time(path, time);
+}
+
+}  // namespace
+
+TEST_CASE("JsonConfig::loadCached", "[config_cache]") {
+    const auto dir = std::filesystem::temp_directory_path() / "msh_utils_config_cache_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const auto source = dir / "config.json";
+    const auto cache = dir / "config.cache";
+
+    REQUIRE(file_io::write(source, ByteView(std::string(R"({"port": 80, "hosts": ["a", "b"]})"))));
+
+    nlohmann::json config;
+    REQUIRE(JsonConfig::loadCached(source, cache, config));
+    REQUIRE(config["port"] == 80);
+    REQUIRE(config["hosts"].size() == 2);
+    REQUIRE(std::filesystem::exists(cache));
+
+    SECTION("unchanged source is served from the cache") {
+        // Same size and time but different text: only the cache can still say 80
+        replaceKeepingStamp(source, R"({"port": 81, "hosts": ["a", "b"]})");
+        nlohmann::json cached;
+        REQUIRE(JsonConfig::loadCached(source, cache, cached));
+        REQUIRE(cached["port"] == 80);
+        REQUIRE(cached == config);
+
+        JsonConfig::CacheOptions verify;
+        verify.verifyHash = true;
+        REQUIRE(JsonConfig::loadCached(source, cache, cached, verify));
+        REQUIRE(cached["port"] == 81);
+    }
+
+    SECTION("modified source is parsed again") {
+        REQUIRE(file_io::write(source, ByteView(std::string(R"({"port": 8080})"))));
+        nlohmann::json reloaded;
+        REQUIRE(JsonConfig::loadCached(source, cache, reloaded));
+        REQUIRE(reloaded["port"] == 8080);
+
+        // The rewritten cache is used from now on
+        replaceKeepingStamp(source, R"({"port": 9090})");
+        REQUIRE(JsonConfig::loadCached(source, cache, reloaded));
+        REQUIRE(reloaded["port"] == 8080);
+    }
+
+    SECTION("damaged cache is rebuilt") {
+        ByteArray bytes;
+        REQUIRE(file_io::read(cache, bytes));
+        bytes.back() ^= 0xFF;
+        REQUIRE(file_io::write(cache, bytes));
+
+        nlohmann::json reloaded;
+        REQUIRE(JsonConfig::loadCached(source, cache, reloaded));
+        REQUIRE(reloaded == config);
+
+        REQUIRE(file_io::write(cache, ByteView(std::string("short"))));
+        REQUIRE(JsonConfig::loadCached(source, cache, reloaded));
+        REQUIRE(reloaded == config);
+    }
+
+    SECTION("explicit cache write") {
+        nlohmann::json validated = {{"port", 443}};
+        REQUIRE(JsonConfig::writeCache(source, cache, validated));
+        nlohmann::json cached;
+        REQUIRE(JsonConfig::loadCached(source, cache, cached));
+        REQUIRE(cached == validated);
+    }
+
+    SECTION("invalid or missing source") {
+        REQUIRE(file_io::write(source, ByteView(std::string("{\"port\": "))));
+        nlohmann::json broken;
+        REQUIRE_FALSE(JsonConfig::loadCached(source, cache, broken));
+        REQUIRE_FALSE(JsonConfig::loadCached(dir / "missing.json", cache, broken));
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("JsonConfig::loadCached: value types", "[config_cache]") {
+    const auto dir = std::filesystem::temp_directory_path() / "msh_utils_config_cache_types_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const auto source = dir / "config.json";
+    const auto cache = dir / "config.cache";
+
+    const std::string text = R"({
+        "null": null, "true": true, "false": false,
+        "negative": -42, "unsigned": 18446744073709551615, "float": 2.5,
+        "string": "text with \"quotes\" and é", "empty": "",
+        "array": [1, [2, [3, []]], {"in": "array"}],
+        "object": {"z": 1, "a": {"nested": {}}, "m": [null]}
+    })";
+    REQUIRE(file_io::write(source, ByteView(text)));
+
+    nlohmann::json parsed;
+    REQUIRE(JsonConfig::loadCached(source, cache, parsed));
+    nlohmann::json cached;
+    REQUIRE(JsonConfig::loadCached(source, cache, cached));
+    REQUIRE(cached == parsed);
+    REQUIRE(cached == nlohmann::json::parse(text));
+    REQUIRE(cached["unsigned"].is_number_unsigned());
+    REQUIRE(cached["negative"].is_number_integer());
+    REQUIRE(cached["float"].is_number_float());
+
+    std::filesystem::remove_all(dir);
+}
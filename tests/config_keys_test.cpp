@@ -0,0 +1,107 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include "msh/utils/JsonConfig.hpp"
+#include "msh/utils/config_keys.hpp"
+#include "nlohmann/json.hpp"
+
+using namespace msh::utils;
+
+namespace {
+
+enum class Level { Low, High };
+NLOHMANN_JSON_SERIALIZE_ENUM(Level, {
+                                        {Level::Low, "low"},
+                                        {Level::High, "high"},
+                                    })
+
+}  // namespace
+
+TEST_CASE("JsonConfig::KeySet: resolve", "[config_keys]") {
+    JsonConfig::KeySet keys;
+    const auto port = keys.add<uint16_t>("port", 8080, 1, 9000);
+    const auto name = keys.add<std::string>("name", "default");
+    const auto enabled = keys.add<bool>("enabled", false);
+    const auto ratio = keys.add<double>("ratio", 0.5);
+    const auto level = keys.add<Level>("level", Level::Low);
+    const auto nested = keys.add<int32_t>("/limits/connections", 16);
+    const auto flag = keys.add<uint8_t>("flag", 1);
+    REQUIRE(keys.size() == 7);
+
+    SECTION("values are read") {
+        nlohmann::json json_data = {{"port", 443},
+                                    {"name", "a name that does not fit in any small buffer"},
+                                    {"enabled", true},
+                                    {"ratio", 0.75},
+                                    {"level", "high"},
+                                    {"limits", {{"connections", 64}}},
+                                    {"flag", 0}};
+        JsonConfig::Report report;
+        const auto values = keys.resolve(json_data, &report);
+        REQUIRE(report.ok());
+        REQUIRE(values[port] == 443);
+        REQUIRE(values[name] == "a name that does not fit in any small buffer");
+        REQUIRE(values[enabled] == true);
+        REQUIRE(values[ratio] == 0.75);
+        REQUIRE(values[level] == Level::High);
+        REQUIRE(nested.get(values) == 64);
+        REQUIRE(values[flag] == 0);
+    }
+
+    SECTION("failures fall back to defaults and are reported") {
+        nlohmann::json json_data = {{"port", 9001},
+                                    {"name", 42},
+                                    {"enabled", nullptr},
+                                    {"level", "high"},
+                                    {"limits", {{"connections", "many"}}},
+                                    {"flag", 256}};
+        JsonConfig::Report report;
+        const auto values = keys.resolve(json_data, &report);
+        REQUIRE(report.issues.size() == 6);
+        REQUIRE(values[port] == 8080);
+        REQUIRE(values[name] == "default");
+        REQUIRE(values[enabled] == false);
+        REQUIRE(values[ratio] == 0.5);
+        REQUIRE(values[level] == Level::High);
+        REQUIRE(values[nested] == 16);
+        REQUIRE(values[flag] == 1);
+    }
+
+    SECTION("reported values are truncated") {
+        JsonConfig::Report report;
+        keys.resolve(nlohmann::json{{"name", std::vector<int>(5000, 7)}}, &report);
+        const auto issue = std::find_if(report.issues.begin(),
+                                        report.issues.end(),
+                                        [](const auto& entry) { return entry.key == "name"; });
+        REQUIRE(issue != report.issues.end());
+        REQUIRE(issue->value.size() < 300);
+    }
+
+    SECTION("tables are independent and movable") {
+        auto first = keys.resolve(nlohmann::json{{"name", "first"}});
+        const auto second = keys.resolve(nlohmann::json{{"name", "second"}});
+        REQUIRE(first[name] == "first");
+        REQUIRE(second[name] == "second");
+
+        JsonConfig::Values moved(std::move(first));
+        REQUIRE(moved[name] == "first");
+        moved = keys.resolve(nlohmann::json::object());
+        REQUIRE(moved[name] == "default");
+    }
+
+    SECTION("non-object document") {
+        const auto values = keys.resolve(nlohmann::json());
+        REQUIRE(values[port] == 8080);
+        REQUIRE(values[nested] == 16);
+    }
+}
+
+TEST_CASE("JsonConfig::KeySet: empty set", "[config_keys]") {
+    JsonConfig::KeySet keys;
+    JsonConfig::Report report;
+    const auto values = keys.resolve(nlohmann::json{{"a", 1}}, &report);
+    REQUIRE(report.ok());
+}
@@ -0,0 +1,194 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "msh/utils/JsonConfig.hpp"
+#include "msh/utils/byte_view.hpp"
+#include "msh/utils/config_store.hpp"
+#include "msh/utils/file_io.hpp"
+
+using namespace msh::utils;
+
+namespace {
+
+bool writeConfig(const std::filesystem::path& path, const std::string& text) {
+    file_io::WriteOptions options;
+    options.atomic = true;
+    return file_io::write(path, ByteView(text), options);
+}
+
+// Waits up to five seconds for the store to reach version
+bool waitForVersion(const JsonConfig::Store& store, const uint64_t version) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (store.version() < version) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST_CASE("JsonConfig::Store: load and reload", "[config_store]") {
+    const auto dir = std::filesystem::temp_directory_path() / "msh_utils_config_store_test";
+    std::filesystem::create_directories(dir);
+    const auto path = dir / "config.json";
+
+    SECTION("empty before load") {
+        JsonConfig::Store store(dir / "missing.json");
+        REQUIRE(store.version() == 0);
+        REQUIRE(store.snapshot()->root.is_null());
+        REQUIRE_FALSE(store.load());
+        REQUIRE(store.version() == 0);
+    }
+
+    SECTION("reload publishes new snapshots, old ones stay valid") {
+        REQUIRE(writeConfig(path, R"({"port": 80})"));
+        JsonConfig::Store store(path);
+        REQUIRE(store.load());
+        REQUIRE(store.version() == 1);
+
+        const auto first = store.snapshot();
+        REQUIRE(JsonConfig::getSafe(first->root, "port", 0) == 80);
+
+        REQUIRE(writeConfig(path, R"({"port": 443})"));
+        REQUIRE(store.reload());
+        REQUIRE(store.version() == 2);
+        REQUIRE(JsonConfig::getSafe(store.snapshot()->root, "port", 0) == 443);
+        REQUIRE(JsonConfig::getSafe(first->root, "port", 0) == 80);
+        REQUIRE(first->version == 1);
+    }
+
+    SECTION("invalid content keeps the current snapshot") {
+        REQUIRE(writeConfig(path, R"({"port": 80})"));
+        JsonConfig::Store store(path);
+        REQUIRE(store.load());
+
+        REQUIRE(writeConfig(path, R"({"port": )"));
+        REQUIRE_FALSE(store.reload());
+        REQUIRE(store.version() == 1);
+        REQUIRE(JsonConfig::getSafe(store.snapshot()->root, "port", 0) == 80);
+    }
+
+    SECTION("reader follows reloads") {
+        REQUIRE(writeConfig(path, R"({"port": 80})"));
+        JsonConfig::Store store(path);
+        JsonConfig::Store::Reader reader(store);
+        REQUIRE(reader.get().version == 0);
+
+        REQUIRE(store.load());
+        REQUIRE(reader->version == 1);
+        REQUIRE(JsonConfig::getSafe(reader->root, "port", 0) == 80);
+
+        REQUIRE(writeConfig(path, R"({"port": 8080})"));
+        REQUIRE(store.reload());
+        REQUIRE(JsonConfig::getSafe(reader->root, "port", 0) == 8080);
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("JsonConfig::Store: keys", "[config_store]") {
+    const auto dir = std::filesystem::temp_directory_path() / "msh_utils_config_store_test";
+    std::filesystem::create_directories(dir);
+    const auto path = dir / "config.json";
+
+    JsonConfig::KeySet keys;
+    const auto port = keys.add<int32_t>("port", 80, 1, 65535);
+    const auto host = keys.add<std::string>("/server/host", "localhost");
+
+    JsonConfig::Store store(path, keys);
+    JsonConfig::Store::Reader reader(store);
+    REQUIRE(reader.get(port) == 80);
+    REQUIRE(reader.get(host) == "localhost");
+
+    REQUIRE(writeConfig(path, R"({"port": 443, "server": {"host": "example.org"}})"));
+    REQUIRE(store.load());
+    REQUIRE(reader.get(port) == 443);
+    REQUIRE(reader.get(host) == "example.org");
+    REQUIRE(reader->report.ok());
+
+    REQUIRE(writeConfig(path, R"({"port": 0})"));
+    REQUIRE(store.reload());
+    REQUIRE(reader.get(port) == 80);
+    REQUIRE(reader.get(host) == "localhost");
+    REQUIRE(reader->report.issues.size() == 2);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("JsonConfig::Store: concurrent readers during reloads", "[config_store]") {
+    const auto dir = std::filesystem::temp_directory_path() / "msh_utils_config_store_test";
+    std::filesystem::create_directories(dir);
+    const auto path = dir / "config.json";
+
+    REQUIRE(writeConfig(path, R"({"a": 0, "b": 0})"));
+    JsonConfig::Store store(path);
+    REQUIRE(store.load());
+
+    std::atomic<bool> stop{false};
+    std::atomic<bool> consistent{true};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&]() {
+            JsonConfig::Store::Reader reader(store);
+            while (!stop.load()) {
+                const auto& snapshot = reader.get();
+                // Both values are written together, a snapshot never mixes two files
+                if (JsonConfig::getSafe(snapshot.root, "a", -1) !=
+                    JsonConfig::getSafe(snapshot.root, "b", -2)) {
+                    consistent = false;
+                }
+            }
+        });
+    }
+
+    for (int i = 1; i <= 50; ++i) {
+        const auto n = std::to_string(i);
+        REQUIRE(writeConfig(path, "{\"a\": " + n + ", \"b\": " + n + "}"));
+        REQUIRE(store.reload());
+    }
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    REQUIRE(consistent);
+    REQUIRE(store.version() == 51);
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("JsonConfig::Store: watch", "[config_store]") {
+    const auto dir = std::filesystem::temp_directory_path() / "msh_utils_config_store_watch_test";
+    std::filesystem::create_directories(dir);
+    const auto path = dir / "config.json";
+
+    REQUIRE(writeConfig(path, R"({"port": 80})"));
+    JsonConfig::Store store(path);
+    REQUIRE(store.load());
+    REQUIRE(store.watch(std::chrono::milliseconds(10)));
+    REQUIRE(store.isWatching());
+
+    // Unrelated files in the same directory are ignored
+    REQUIRE(writeConfig(dir / "other.json", "{}"));
+
+    // Modification times may have a coarse resolution, so keep rewriting until noticed
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (store.version() < 2 && std::chrono::steady_clock::now() < deadline) {
+        REQUIRE(writeConfig(path, R"({"port": 443})"));
+        waitForVersion(store, 2);
+    }
+    REQUIRE(store.version() >= 2);
+    REQUIRE(JsonConfig::getSafe(store.snapshot()->root, "port", 0) == 443);
+
+    store.unwatch();
+    REQUIRE_FALSE(store.isWatching());
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,182 @@
+#include "msh/utils/file_arena.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace msh::utils;
+
+namespace {
+
+ByteArray fileContents(const size_t size, const size_t seed) {
+    ByteArray data;
+    data.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(i * 31 + seed);
+    }
+    return data;
+}
+
+}  // namespace
+
+TEST_CASE("file_arena: loadDirectory", "[file_arena]") {
+    auto temp_dir = std::filesystem::temp_directory_path() / "msh_utils_arena_test";
+    std::filesystem::remove_all(temp_dir);
+    std::filesystem::create_directories(temp_dir / "models" / "deep");
+    std::filesystem::create_directories(temp_dir / "empty_dir");
+
+    const std::vector<std::pair<std::string, size_t>> layout = {
+        {"a.bin", 100},
+        {"b.txt", 0},
+        {"models/m1.bin", 5000},
+        {"models/deep/m2.bin", 1},
+        {"z.bin", 70000},
+    };
+    for (size_t i = 0; i < layout.size(); ++i) {
+        REQUIRE(file_io::write(temp_dir / layout[i].first, fileContents(layout[i].second, i)));
+    }
+
+    SECTION("recursive") {
+        file_io::FileArena files;
+        REQUIRE(file_io::loadDirectory(temp_dir, files));
+        REQUIRE(files.size() == layout.size());
+
+        for (size_t i = 0; i < layout.size(); ++i) {
+            const auto contents = files.find(layout[i].first);
+            REQUIRE(contents.has_value());
+            REQUIRE(*contents == fileContents(layout[i].second, i));
+            REQUIRE(files.at(layout[i].first) == *contents);
+        }
+
+        // Sorted by path, aligned, zero padded and packed in path order
+        const auto& entries = files.entries();
+        size_t end = 0;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (i > 0) {
+                REQUIRE(entries[i - 1].path < entries[i].path);
+            }
+            REQUIRE(entries[i].offset % 16 == 0);
+            REQUIRE(entries[i].offset >= end);
+            for (size_t pos = end; pos < entries[i].offset; ++pos) {
+                REQUIRE(files.arena()[pos] == 0);
+            }
+            end = entries[i].offset + entries[i].size;
+        }
+        REQUIRE(files.arena().size() == end);
+    }
+
+    SECTION("views survive a move") {
+        file_io::FileArena files;
+        REQUIRE(file_io::loadDirectory(temp_dir, files));
+        const auto before = files.at("z.bin");
+
+        file_io::FileArena moved = std::move(files);
+        REQUIRE(moved.at("z.bin").data() == before.data());
+    }
+
+    SECTION("views of a tiny arena survive a move") {
+        const auto tiny_dir = temp_dir / "tiny";
+        std::filesystem::create_directories(tiny_dir);
+        REQUIRE(file_io::write(tiny_dir / "small.txt", ByteView("hello")));
+        REQUIRE(file_io::write(tiny_dir / "empty.txt", ByteView()));
+
+        file_io::FileArena files;
+        REQUIRE(file_io::loadDirectory(tiny_dir, files));
+        const auto small = files.at("small.txt");
+        const auto empty = files.at("empty.txt");
+
+        file_io::FileArena moved(std::move(files));
+        REQUIRE(moved.at("small.txt").data() == small.data());
+        REQUIRE(moved.at("empty.txt").data() == empty.data());
+        REQUIRE(moved.at("small.txt") == ByteView("hello"));
+    }
+
+    SECTION("top level only") {
+        file_io::LoadOptions options;
+        options.recursive = false;
+        file_io::FileArena files;
+        REQUIRE(file_io::loadDirectory(temp_dir, files, options));
+        REQUIRE(files.size() == 3);
+        REQUIRE(files.contains("a.bin"));
+        REQUIRE_FALSE(files.contains("models/m1.bin"));
+    }
+
+    SECTION("missing entries") {
+        file_io::FileArena files;
+        REQUIRE(file_io::loadDirectory(temp_dir, files));
+        REQUIRE_FALSE(files.find("nonexistent.bin").has_value());
+        REQUIRE_FALSE(files.contains("models"));
+        REQUIRE_THROWS_AS(files.at("nonexistent.bin"), std::out_of_range);
+    }
+
+    SECTION("failures clear the arena") {
+        file_io::FileArena files;
+        REQUIRE(file_io::loadDirectory(temp_dir, files));
+        REQUIRE_FALSE(file_io::loadDirectory(temp_dir / "nonexistent", files));
+        REQUIRE(files.empty());
+
+        file_io::LoadOptions options;
+        options.alignment = 24;
+        REQUIRE_FALSE(file_io::loadDirectory(temp_dir, files, options));
+        REQUIRE(files.empty());
+    }
+
+    SECTION("empty directory") {
+        file_io::FileArena files;
+        REQUIRE(file_io::loadDirectory(temp_dir / "empty_dir", files));
+        REQUIRE(files.empty());
+        REQUIRE(files.arena().empty());
+    }
+
+    std::filesystem::remove_all(temp_dir);
+}
+
+TEST_CASE("file_arena: loadFiles", "[file_arena]") {
+    auto temp_dir = std::filesystem::temp_directory_path() / "msh_utils_arena_test";
+    std::filesystem::remove_all(temp_dir);
+    std::filesystem::create_directories(temp_dir);
+
+    // Enough files for several batches on several threads
+    std::vector<std::filesystem::path> manifest;
+    for (size_t i = 0; i < 300; ++i) {
+        manifest.push_back(temp_dir / ("asset_" + std::to_string(i) + ".bin"));
+        REQUIRE(file_io::write(manifest.back(), fileContents(i * 37 % 1000, i)));
+    }
+
+    SECTION("threads and prefetch depths") {
+        for (const unsigned threads : {0u, 1u, 4u}) {
+            for (const size_t prefetch : {size_t{0}, size_t{7}, size_t{1000}}) {
+                file_io::LoadOptions options;
+                options.threads = threads;
+                options.prefetch = prefetch;
+                options.alignment = 1;
+                file_io::FileArena files;
+                REQUIRE(file_io::loadFiles(manifest, files, options));
+                REQUIRE(files.size() == manifest.size());
+                for (size_t i = 0; i < manifest.size(); ++i) {
+                    REQUIRE(files.at(manifest[i]) == fileContents(i * 37 % 1000, i));
+                }
+            }
+        }
+    }
+
+    SECTION("duplicates are loaded once") {
+        std::vector<std::filesystem::path> paths = {manifest[3], manifest[1], manifest[3]};
+        file_io::FileArena files;
+        REQUIRE(file_io::loadFiles(paths, files));
+        REQUIRE(files.size() == 2);
+        REQUIRE(files.at(manifest[3]) == fileContents(3 * 37 % 1000, 3));
+    }
+
+    SECTION("missing file fails") {
+        auto paths = manifest;
+        paths.push_back(temp_dir / "nonexistent.bin");
+        file_io::FileArena files;
+        REQUIRE_FALSE(file_io::loadFiles(paths, files));
+        REQUIRE(files.empty());
+    }
+
+    std::filesystem::remove_all(temp_dir);
+}
@@ -1,4 +1,5 @@
 #include "msh/utils/file_io.hpp"
+#include "msh/utils/hash.hpp"
 
 #include <catch2/catch_test_macros.hpp>
 #include <filesystem>
@@ -77,6 +78,339 @@ TEST_CASE("file_io: large file operations", "[file_io]") {
         REQUIRE(read_data.size() == file_size);
     }
 
+    SECTION("parallel read matches the sequential read") {
+        ByteArray expected;
+        REQUIRE(file_io::read(test_file, expected));
+        for (const unsigned threads : {0u, 1u, 3u, 16u}) {
+            file_io::ParallelReadOptions options;
+            options.threads = threads;
+            options.chunkSize = 1 << 20;
+            ByteArray read_data;
+            REQUIRE(file_io::read(test_file, read_data, options));
+            REQUIRE(read_data == expected);
+        }
+    }
+
     // Cleanup
     std::filesystem::remove_all(temp_dir);
-}
\ No newline at end of file
+}
+
+TEST_CASE("file_io: parallel read", "[file_io]") {
+    auto temp_dir = std::filesystem::temp_directory_path() / "msh_utils_test";
+    std::filesystem::create_directories(temp_dir);
+    auto test_file = temp_dir / "parallel.bin";
+
+    file_io::ParallelReadOptions options;
+    options.threads = 4;
+    // Rounded down to 4 KiB
+    options.chunkSize = 5000;
+
+    SECTION("sizes around the chunk size") {
+        for (const size_t size : {size_t{0}, size_t{1}, size_t{4095}, size_t{4096}, size_t{4097},
+                                  size_t{3 * 4096 + 17}, size_t{100 * 4096 + 1}}) {
+            ByteArray test_data;
+            test_data.resize(size);
+            for (size_t i = 0; i < size; ++i) {
+                test_data[i] = static_cast<uint8_t>(i * 131 + i / 4096);
+            }
+            REQUIRE(file_io::write(test_file, test_data));
+
+            ByteArray read_data(size_t{10}, 0xFF);
+            REQUIRE(file_io::read(test_file, read_data, options));
+            REQUIRE(read_data == test_data);
+        }
+    }
+
+    SECTION("failures") {
+        ByteArray read_data;
+        REQUIRE_FALSE(file_io::read(temp_dir / "nonexistent.bin", read_data, options));
+
+        REQUIRE(file_io::write(test_file, ByteView("data")));
+        options.chunkSize = 0;
+        REQUIRE_FALSE(file_io::read(test_file, read_data, options));
+    }
+
+    std::filesystem::remove_all(temp_dir);
+}
+
+TEST_CASE("file_io: MappedFile", "[file_io]") {
+    auto temp_dir = std::filesystem::temp_directory_path() / "msh_utils_test";
+    std::filesystem::create_directories(temp_dir);
+    auto test_file = temp_dir / "mapped.bin";
+
+    ByteArray test_data;
+    test_data.resize(64 * 1024);
+    for (size_t i = 0; i < test_data.size(); ++i) {
+        test_data[i] = static_cast<uint8_t>(i * 31);
+    }
+    REQUIRE(file_io::write(test_file, test_data));
+
+    SECTION("map and compare contents") {
+        file_io::MappedFile mapped(test_file, file_io::AccessHint::Sequential);
+        REQUIRE(mapped.isOpen());
+        REQUIRE(mapped.size() == test_data.size());
+        CHECK(std::equal(mapped.begin(), mapped.end(), test_data.begin()));
+        CHECK(mapped.view() == test_data);
+        CHECK(mapped.advise(file_io::AccessHint::Random));
+    }
+
+    SECTION("write a view of a mapped file") {
+        file_io::MappedFile mapped(test_file);
+        auto slice_file = temp_dir / "slice.bin";
+        REQUIRE(file_io::write(slice_file, mapped.view().subview(100, 1000)));
+
+        ByteArray read_data;
+        REQUIRE(file_io::read(slice_file, read_data));
+        CHECK(read_data == test_data.view().subview(100, 1000));
+    }
+
+    SECTION("move transfers the mapping") {
+        file_io::MappedFile first(test_file);
+        const auto* data = first.data();
+        file_io::MappedFile second(std::move(first));
+        CHECK_FALSE(first.isOpen());
+        CHECK(first.data() == nullptr);
+        CHECK(second.data() == data);
+        CHECK(second.size() == test_data.size());
+    }
+
+    SECTION("map empty file") {
+        auto empty_file = temp_dir / "empty.bin";
+        REQUIRE(file_io::write(empty_file, ByteArray{}));
+        file_io::MappedFile mapped;
+        REQUIRE(mapped.open(empty_file));
+        CHECK(mapped.isOpen());
+        CHECK(mapped.empty());
+        CHECK(mapped.begin() == mapped.end());
+    }
+
+    SECTION("map non-existent file") {
+        file_io::MappedFile mapped;
+        CHECK_FALSE(mapped.open(temp_dir / "nonexistent.bin"));
+        CHECK_FALSE(mapped.isOpen());
+    }
+
+    SECTION("close releases the mapping") {
+        file_io::MappedFile mapped(test_file);
+        mapped.close();
+        CHECK_FALSE(mapped.isOpen());
+        CHECK(mapped.empty());
+    }
+
+    std::filesystem::remove_all(temp_dir);
+}
+
+TEST_CASE("file_io: streaming Reader and Writer", "[file_io]") {
+    auto temp_dir = std::filesystem::temp_directory_path() / "msh_utils_test";
+    std::filesystem::create_directories(temp_dir);
+    auto test_file = temp_dir / "stream.bin";
+
+    ByteArray test_data(100 * 1000);
+    for (size_t i = 0; i < test_data.size(); ++i) {
+        test_data[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+
+    file_io::StreamOptions options;
+    options.bufferSize = 4096;
+
+    SECTION("write in uneven chunks and read back in fixed chunks") {
+        file_io::Writer writer(test_file, options);
+        REQUIRE(writer.isOpen());
+        ByteView remaining = test_data;
+        for (size_t step = 1; !remaining.empty(); step = step * 3 + 1) {
+            const auto n = std::min(step, remaining.size());
+            REQUIRE(writer.write(remaining.subview(0, n)));
+            remaining.remove_prefix(n);
+        }
+        CHECK(writer.offset() == test_data.size());
+        REQUIRE(writer.close());
+
+        options.dropCache = true;
+        file_io::Reader reader(test_file, options);
+        REQUIRE(reader.isOpen());
+        ByteArray chunk;
+        ByteArray read_data;
+        size_t chunks = 0;
+        while (reader.read(chunk)) {
+            CHECK(chunk.size() <= options.bufferSize);
+            read_data.append(chunk);
+            ++chunks;
+        }
+        CHECK(reader.eof());
+        CHECK(chunk.empty());
+        CHECK(chunks == (test_data.size() + options.bufferSize - 1) / options.bufferSize);
+        CHECK(reader.offset() == test_data.size());
+        CHECK(read_data == test_data);
+    }
+
+    SECTION("checksum while reading") {
+        REQUIRE(file_io::write(test_file, test_data));
+        file_io::Reader reader(test_file, options);
+        hash::Crc32c crc;
+        hash::Hasher64 hasher;
+        ByteArray chunk;
+        while (reader.read(chunk, crc)) {
+            hasher.update(chunk);
+        }
+        CHECK(reader.eof());
+        CHECK(crc.value() == hash::crc32c(test_data.data(), test_data.size()));
+        CHECK(hasher.value() == hash::hash64(test_data.data(), test_data.size()));
+    }
+
+    SECTION("file size is a multiple of the chunk size") {
+        REQUIRE(file_io::write(test_file, test_data.view().subview(0, 3 * options.bufferSize)));
+        file_io::Reader reader(test_file, options);
+        ByteArray chunk;
+        size_t chunks = 0;
+        while (reader.read(chunk)) {
+            CHECK(chunk.size() == options.bufferSize);
+            ++chunks;
+        }
+        CHECK(chunks == 3);
+        CHECK(reader.eof());
+    }
+
+    SECTION("read empty file") {
+        REQUIRE(file_io::write(test_file, ByteArray{}));
+        file_io::Reader reader(test_file, options);
+        ByteArray chunk;
+        CHECK_FALSE(reader.read(chunk));
+        CHECK(reader.eof());
+    }
+
+    SECTION("open failures") {
+        file_io::Reader reader;
+        CHECK_FALSE(reader.open(temp_dir / "nonexistent.bin"));
+        ByteArray chunk;
+        CHECK_FALSE(reader.read(chunk));
+        CHECK_FALSE(reader.eof());
+
+        file_io::Writer writer;
+        CHECK_FALSE(writer.open(temp_dir / "invalid/path/test.bin"));
+        CHECK_FALSE(writer.write(test_data));
+    }
+
+    std::filesystem::remove_all(temp_dir);
+}
+
+TEST_CASE("file_io: atomic and vectored writes", "[file_io]") {
+    auto temp_dir = std::filesystem::temp_directory_path() / "msh_utils_test";
+    std::filesystem::create_directories(temp_dir);
+    auto test_file = temp_dir / "atomic.bin";
+
+    ByteArray header{0x01, 0x02, 0x03};
+    ByteArray body(10000, 0xAB);
+    ByteArray trailer{0xFF};
+    ByteArray expected = header;
+    expected.append(body);
+    expected.append(trailer);
+
+    SECTION("atomic write replaces existing contents for every durability") {
+        REQUIRE(file_io::write(test_file, ByteArray(50000, 0x11)));
+
+        for (const auto durability :
+             {file_io::Durability::None, file_io::Durability::Data, file_io::Durability::Full}) {
+            file_io::WriteOptions options;
+            options.atomic = true;
+            options.durability = durability;
+            REQUIRE(file_io::write(test_file, body, options));
+
+            ByteArray read_data;
+            REQUIRE(file_io::read(test_file, read_data));
+            CHECK(read_data == body);
+        }
+
+        // No temporary files are left behind
+        size_t entries = 0;
+        for ([[maybe_unused]] const auto& entry : std::filesystem::directory_iterator(temp_dir)) {
+            ++entries;
+        }
+        CHECK(entries == 1);
+    }
+
+    SECTION("durable write in place") {
+        file_io::WriteOptions options;
+        options.durability = file_io::Durability::Full;
+        REQUIRE(file_io::write(test_file, body, options));
+        ByteArray read_data;
+        REQUIRE(file_io::read(test_file, read_data));
+        CHECK(read_data == body);
+    }
+
+    SECTION("vectored write") {
+        REQUIRE(file_io::write(test_file, {header, body, ByteView(), trailer}));
+        ByteArray read_data;
+        REQUIRE(file_io::read(test_file, read_data));
+        CHECK(read_data == expected);
+
+        std::vector<ByteView> buffers(2000, ByteView(header));
+        file_io::WriteOptions options;
+        options.atomic = true;
+        REQUIRE(file_io::write(test_file, buffers, options));
+        REQUIRE(file_io::read(test_file, read_data));
+        CHECK(read_data.size() == 2000 * header.size());
+        CHECK(read_data.view().subview(5997) == header);
+    }
+
+    SECTION("chain write") {
+        ByteChain chain;
+        chain.appendRef(body);
+        chain.prependRef(header);
+        chain.appendCopy(trailer);
+        REQUIRE(file_io::write(test_file, chain));
+        ByteArray read_data;
+        REQUIRE(file_io::read(test_file, read_data));
+        CHECK(read_data == expected);
+
+        file_io::StreamOptions stream_options;
+        stream_options.bufferSize = 4096;
+        file_io::Writer writer(test_file, stream_options);
+        ByteChain small;
+        small.appendRef(header);
+        small.appendRef(trailer);
+        REQUIRE(writer.write(small));
+        REQUIRE(writer.write(chain));
+        REQUIRE(writer.write(small));
+        CHECK(writer.offset() == 2 * small.size() + chain.size());
+        REQUIRE(writer.close());
+        REQUIRE(file_io::read(test_file, read_data));
+        ByteArray written = small.flatten();
+        written.append(expected);
+        written.append(small.flatten());
+        CHECK(read_data == written);
+    }
+
+#ifndef _WIN32
+    SECTION("atomic write keeps the mode and follows symlinks") {
+        namespace fs = std::filesystem;
+        file_io::WriteOptions options;
+        options.atomic = true;
+
+        REQUIRE(file_io::write(test_file, header));
+        fs::permissions(test_file, fs::perms::owner_read | fs::perms::owner_write);
+        REQUIRE(file_io::write(test_file, body, options));
+        CHECK(fs::status(test_file).permissions() ==
+              (fs::perms::owner_read | fs::perms::owner_write));
+
+        fs::permissions(test_file, fs::perms::owner_all | fs::perms::group_read);
+        const auto link = temp_dir / "link.bin";
+        fs::create_symlink(test_file.filename(), link);
+        REQUIRE(file_io::write(link, trailer, options));
+        CHECK(fs::is_symlink(fs::symlink_status(link)));
+        CHECK(fs::status(test_file).permissions() ==
+              (fs::perms::owner_all | fs::perms::group_read));
+
+        ByteArray read_data;
+        REQUIRE(file_io::read(test_file, read_data));
+        CHECK(read_data == trailer);
+    }
+#endif
+
+    SECTION("atomic write to invalid path") {
+        file_io::WriteOptions options;
+        options.atomic = true;
+        REQUIRE_FALSE(file_io::write(temp_dir / "invalid/path/test.bin", body, options));
+    }
+
+    std::filesystem::remove_all(temp_dir);
+}
@@ -0,0 +1,119 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "msh/utils/byte_array.hpp"
+#include "msh/utils/byte_view.hpp"
+#include "msh/utils/hash.hpp"
+#include "msh/utils/shared_bytes.hpp"
+
+using namespace msh::utils;
+
+namespace {
+
+ByteArray randomBytes(const size_t size, const uint32_t seed) {
+    std::mt19937 rng(seed);
+    ByteArray bytes(size);
+    for (auto& byte : bytes) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    return bytes;
+}
+
+}  // namespace
+
+TEST_CASE("hash: crc32c", "[hash]") {
+    SECTION("Known values") {
+        const std::string check = "123456789";
+        REQUIRE(hash::crc32c(check.data(), check.size()) == 0xE3069283u);
+        REQUIRE(hash::crc32c(nullptr, 0) == 0);
+
+        const ByteArray zeros(32, 0x00);
+        REQUIRE(hash::crc32c(zeros.data(), zeros.size()) == 0x8A9136AAu);
+        const ByteArray ones(32, 0xFF);
+        REQUIRE(hash::crc32c(ones.data(), ones.size()) == 0x62A8AB43u);
+    }
+
+    SECTION("Hardware and table kernels agree") {
+        for (const size_t size : {0, 1, 3, 7, 8, 9, 63, 64, 1000, 4099, 12288, 12297, 40000}) {
+            const ByteArray bytes = randomBytes(size, static_cast<uint32_t>(size));
+            const uint32_t scalar = ~hash::detail::crc32cScalar(~0u, bytes.data(), bytes.size());
+            REQUIRE(hash::crc32c(bytes.data(), bytes.size()) == scalar);
+        }
+    }
+
+    SECTION("Streaming in pieces") {
+        const ByteArray bytes = randomBytes(10000, 1);
+        const uint32_t whole = hash::crc32c(bytes.data(), bytes.size());
+
+        hash::Crc32c crc;
+        ByteView remaining = bytes;
+        for (size_t step = 1; !remaining.empty(); step = step * 2 + 1) {
+            const auto n = std::min(step, remaining.size());
+            crc.update(remaining.subview(0, n));
+            remaining.remove_prefix(n);
+        }
+        REQUIRE(crc.value() == whole);
+
+        crc.reset();
+        REQUIRE(crc.value() == 0);
+    }
+}
+
+TEST_CASE("hash: hash64", "[hash]") {
+    SECTION("Deterministic and seed dependent") {
+        const ByteArray bytes = randomBytes(100, 2);
+        REQUIRE(hash::hash64(bytes.data(), bytes.size()) ==
+                hash::hash64(bytes.data(), bytes.size()));
+        REQUIRE(hash::hash64(bytes.data(), bytes.size(), 1) !=
+                hash::hash64(bytes.data(), bytes.size(), 2));
+        REQUIRE(hash::hash64(nullptr, 0) == hash::hash64(bytes.data(), 0));
+    }
+
+    SECTION("Every length and single bit flips give distinct values") {
+        const ByteArray bytes = randomBytes(300, 3);
+        std::unordered_set<uint64_t> seen;
+        for (size_t size = 0; size <= bytes.size(); ++size) {
+            REQUIRE(seen.insert(hash::hash64(bytes.data(), size)).second);
+        }
+
+        ByteArray flipped = bytes;
+        for (size_t bit = 0; bit < 8 * flipped.size(); bit += 7) {
+            flipped[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+            REQUIRE(seen.insert(hash::hash64(flipped.data(), flipped.size())).second);
+            flipped[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+        }
+    }
+
+    SECTION("Streaming matches one-shot for every split") {
+        const ByteArray bytes = randomBytes(500, 4);
+        for (size_t size : {0, 1, 4, 15, 16, 17, 47, 48, 49, 64, 95, 96, 97, 144, 145, 500}) {
+            const uint64_t whole = hash::hash64(bytes.data(), size, 7);
+            for (size_t step : {1, 5, 16, 47, 48, 49, 100}) {
+                hash::Hasher64 hasher(7);
+                for (size_t offset = 0; offset < size; offset += step) {
+                    hasher.update(bytes.data() + offset, std::min(step, size - offset));
+                }
+                REQUIRE(hasher.value() == whole);
+            }
+        }
+    }
+}
+
+TEST_CASE("hash: std::hash specializations", "[hash]") {
+    const ByteArray bytes = {1, 2, 3, 4, 5};
+    const size_t expected = std::hash<ByteArray>()(bytes);
+    REQUIRE(std::hash<ByteView>()(bytes.view()) == expected);
+    REQUIRE(std::hash<SharedBytes>()(SharedBytes(bytes.view())) == expected);
+
+    std::unordered_map<ByteArray, int> counts;
+    for (int i = 0; i < 1000; ++i) {
+        ++counts[ByteArray(std::to_string(i % 100))];
+    }
+    REQUIRE(counts.size() == 100);
+    REQUIRE(counts[ByteArray(std::string("42"))] == 10);
+}
@@ -1,5 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
 #include "msh/utils/JsonConfig.hpp"
 #include "msh/utils/file_io.hpp"
 #include "nlohmann/json.hpp"
@@ -103,6 +107,21 @@ TEST_CASE("T getSafe(const json& j, const std::string& key, const T& default_val
         int8_t missing_value = JsonConfig::getSafe(json_data, "missing_key", int8_t{});
         REQUIRE(missing_value == 0);
     }
+
+    SECTION("ByteArray from base64") {
+        nlohmann::json json_data = {{"key", "3q2+7w=="},
+                                    {"url_key", "3q2-7w"},
+                                    {"malformed", "3q2+7w="},
+                                    {"wrong_type", 42}};
+        const ByteArray fallback{0x01};
+        REQUIRE(JsonConfig::getSafe(json_data, "key", fallback) ==
+                ByteArray{0xDE, 0xAD, 0xBE, 0xEF});
+        REQUIRE(JsonConfig::getSafe(json_data, "url_key", fallback) ==
+                ByteArray{0xDE, 0xAD, 0xBE, 0xEF});
+        REQUIRE(JsonConfig::getSafe(json_data, "malformed", fallback) == fallback);
+        REQUIRE(JsonConfig::getSafe(json_data, "wrong_type", fallback) == fallback);
+        REQUIRE(JsonConfig::getSafe(json_data, "missing_key", fallback) == fallback);
+    }
 }
 
 TEST_CASE("T getSafe(const json& j, const std::string& key)", "[json_config]") {
@@ -194,4 +213,306 @@ TEST_CASE("T getSafe(const json& j, const std::string& key)", "[json_config]") {
         int8_t missing_value = JsonConfig::getSafe<int8_t>(json_data, "missing_key");
         REQUIRE(missing_value == 0);
     }
-}
\ No newline at end of file
+}
+
+struct SchemaConfig {
+    std::string host;
+    uint16_t port = 0;
+    bool verbose = false;
+    double ratio = 0.0;
+    MyEnum mode = MyEnum::Default;
+};
+
+static const JsonConfig::Schema<SchemaConfig>& schemaConfigSchema() {
+    static const auto schema = JsonConfig::Schema<SchemaConfig>()
+                                   .field(&SchemaConfig::host, "host", "localhost")
+                                   .field(&SchemaConfig::port, "port", 8080, 1, 9000)
+                                   .field(&SchemaConfig::verbose, "verbose", false)
+                                   .field(&SchemaConfig::ratio, "ratio", 0.5, 0.0, 1.0)
+                                   .field(&SchemaConfig::mode, "mode", MyEnum::Value1);
+    return schema;
+}
+
+TEST_CASE("JsonConfig::Schema", "[json_config]") {
+    const auto& schema = schemaConfigSchema();
+
+    SECTION("all fields valid") {
+        nlohmann::json json_data = {{"host", "example.org"},
+                                    {"port", 443},
+                                    {"verbose", true},
+                                    {"ratio", 0.25},
+                                    {"mode", "value2"},
+                                    {"unrelated", 1}};
+        SchemaConfig config;
+        const auto report = schema.bind(json_data, config);
+        REQUIRE(report.ok());
+        REQUIRE(config.host == "example.org");
+        REQUIRE(config.port == 443);
+        REQUIRE(config.verbose == true);
+        REQUIRE(config.ratio == 0.25);
+        REQUIRE(config.mode == MyEnum::Value2);
+    }
+
+    SECTION("every problem is reported and defaulted") {
+        nlohmann::json json_data = {
+            {"host", 42}, {"port", 70000}, {"verbose", nullptr}, {"ratio", 1.5}};
+        SchemaConfig config;
+        config.host = "stale";
+        config.port = 1;
+        const auto report = schema.bind(json_data, config);
+        REQUIRE_FALSE(report.ok());
+        REQUIRE(report.issues.size() == 5);
+        REQUIRE(config.host == "localhost");
+        REQUIRE(config.port == 8080);
+        REQUIRE(config.verbose == false);
+        REQUIRE(config.ratio == 0.5);
+        REQUIRE(config.mode == MyEnum::Value1);
+
+        auto kindOf = [&report](const std::string& key) {
+            for (const auto& issue : report.issues) {
+                if (issue.key == key) {
+                    return issue.kind;
+                }
+            }
+            FAIL("no issue for " << key);
+            return JsonConfig::Issue::Kind::Missing;
+        };
+        REQUIRE(kindOf("host") == JsonConfig::Issue::Kind::InvalidType);
+        REQUIRE(kindOf("port") == JsonConfig::Issue::Kind::OutOfRange);
+        REQUIRE(kindOf("verbose") == JsonConfig::Issue::Kind::Null);
+        REQUIRE(kindOf("ratio") == JsonConfig::Issue::Kind::OutOfRange);
+        REQUIRE(kindOf("mode") == JsonConfig::Issue::Kind::Missing);
+
+        const auto text = report.toString();
+        REQUIRE(text.find("j[\"port\"] out of range: 70000") != std::string::npos);
+        REQUIRE(text.find("j[\"mode\"] missing") != std::string::npos);
+    }
+
+    SECTION("reported values are truncated") {
+        nlohmann::json json_data = {{"host", std::vector<int>(5000, 7)}};
+        SchemaConfig config;
+        const auto report = schema.bind(json_data, config);
+        REQUIRE(report.issues[0].key == "host");
+        REQUIRE(report.issues[0].value.size() < 300);
+    }
+
+    SECTION("user range bound") {
+        nlohmann::json json_data = {{"port", 9001}};
+        SchemaConfig config;
+        schema.bind(json_data, config);
+        REQUIRE(config.port == 8080);
+    }
+
+    SECTION("non-object input") {
+        SchemaConfig config;
+        const auto report = schema.bind(nlohmann::json::array({1, 2}), config);
+        REQUIRE(report.issues.size() == 5);
+        REQUIRE(config.host == "localhost");
+    }
+}
+
+TEST_CASE("getSafe key overloads", "[json_config]") {
+    nlohmann::json json_data = {{"port", 8080}, {"name", "server"}};
+
+    const std::string_view view_key = "port";
+    REQUIRE(JsonConfig::getSafe(json_data, view_key, int32_t{}) == 8080);
+    REQUIRE(JsonConfig::getSafe<int32_t>(json_data, view_key) == 8080);
+
+    const char* pointer_key = "name";
+    REQUIRE(JsonConfig::getSafe(json_data, pointer_key, std::string()) == "server");
+    REQUIRE(JsonConfig::getSafe<std::string>(json_data, pointer_key) == "server");
+
+    const std::string string_key = "port";
+    REQUIRE(JsonConfig::getSafe(json_data, string_key, int32_t{}) == 8080);
+
+    // A key that is a prefix of an existing one is not a match
+    REQUIRE(JsonConfig::getSafe(json_data, std::string_view("portx").substr(0, 3), 7) == 7);
+
+    // Lookups on anything but an object fall back to the default
+    REQUIRE(JsonConfig::getSafe(nlohmann::json::array({1}), "port", 7) == 7);
+    REQUIRE(JsonConfig::getSafe(nlohmann::json(), "port", 7) == 7);
+}
+
+TEST_CASE("getSafe json_pointer", "[json_config]") {
+    nlohmann::json json_data = {
+        {"server", {{"ports", {80, 443}}, {"host", "example.org"}, {"a/b", true}, {"m~n", 3}}},
+        {"null", nullptr}};
+
+    using nlohmann::json_literals::operator""_json_pointer;
+    REQUIRE(JsonConfig::getSafe(json_data, "/server/host"_json_pointer, std::string()) ==
+            "example.org");
+    REQUIRE(JsonConfig::getSafe(json_data, "/server/ports/1"_json_pointer, int32_t{}) == 443);
+    REQUIRE(JsonConfig::getSafe<bool>(json_data, "/server/a~1b"_json_pointer) == true);
+    REQUIRE(JsonConfig::getSafe<int32_t>(json_data, "/server/m~0n"_json_pointer) == 3);
+
+    REQUIRE(JsonConfig::getSafe(json_data, "/server/ports/2"_json_pointer, 7) == 7);
+    REQUIRE(JsonConfig::getSafe(json_data, "/server/ports/01"_json_pointer, 7) == 7);
+    REQUIRE(JsonConfig::getSafe(json_data, "/server/ports/x"_json_pointer, 7) == 7);
+    // 2^64 + 1 would wrap around to index 1
+    REQUIRE(JsonConfig::getSafe(json_data, "/server/ports/18446744073709551617"_json_pointer, 7) ==
+            7);
+    REQUIRE(JsonConfig::getSafe(json_data, "/server/missing"_json_pointer, 7) == 7);
+    REQUIRE(JsonConfig::getSafe(json_data, "/server/host/deeper"_json_pointer, 7) == 7);
+    REQUIRE(JsonConfig::getSafe(json_data, "/null"_json_pointer, 7) == 7);
+    REQUIRE(JsonConfig::getSafe(json_data, "/server/host"_json_pointer, 7) == 7);
+
+    // The empty pointer refers to the whole document
+    REQUIRE(JsonConfig::getSafe(nlohmann::json(5), nlohmann::json::json_pointer(), 7) == 5);
+
+    // String pointers, walked in place; malformed ones read as missing
+    constexpr JsonConfig::Pointer port{"/server/ports/1"};
+    REQUIRE(JsonConfig::getSafe(json_data, port, int32_t{}) == 443);
+    REQUIRE(JsonConfig::getSafe<int32_t>(json_data, JsonConfig::Pointer{"/server/m~0n"}) == 3);
+    REQUIRE(JsonConfig::getSafe(nlohmann::json(5), JsonConfig::Pointer{""}, 7) == 5);
+    REQUIRE(JsonConfig::getSafe(json_data, JsonConfig::Pointer{"server/host"}, 7) == 7);
+    REQUIRE(JsonConfig::getSafe(json_data, JsonConfig::Pointer{"/server/m~2n"}, 7) == 7);
+    REQUIRE(JsonConfig::getSafe(json_data, JsonConfig::Pointer{"/server/m~"}, 7) == 7);
+}
+
+TEST_CASE("getSafe diagnostics", "[json_config]") {
+    using Kind = JsonConfig::Issue::Kind;
+    using Mode = JsonConfig::DiagnosticsPolicy::Mode;
+    using nlohmann::json_literals::operator""_json_pointer;
+
+    nlohmann::json json_data = {
+        {"port", "not a number"}, {"small", 300}, {"empty", nullptr}, {"ok", 1}};
+    JsonConfig::resetDiagnostics();
+
+    auto countersOf = [](const std::string& key) {
+        for (const auto& entry : JsonConfig::diagnostics()) {
+            if (entry.key == key) {
+                return entry;
+            }
+        }
+        return JsonConfig::KeyDiagnostics{key, {}, 0};
+    };
+
+    SECTION("counters per key and kind") {
+        JsonConfig::DiagnosticsPolicy silent;
+        silent.mode = Mode::Silent;
+        for (int i = 0; i < 3; ++i) {
+            JsonConfig::getSafe(json_data, "port", 0, silent);
+            JsonConfig::getSafe(json_data, "small", uint8_t{}, silent);
+            JsonConfig::getSafe(json_data, "empty", 0, silent);
+            JsonConfig::getSafe(json_data, "missing", 0, silent);
+            JsonConfig::getSafe(json_data, "ok", 0, silent);
+        }
+        REQUIRE(countersOf("port").count(Kind::InvalidType) == 3);
+        REQUIRE(countersOf("small").count(Kind::OutOfRange) == 3);
+        REQUIRE(countersOf("empty").count(Kind::Null) == 3);
+        REQUIRE(countersOf("missing").count(Kind::Missing) == 3);
+        REQUIRE(countersOf("missing").total() == 3);
+        REQUIRE(countersOf("missing").emitted == 0);
+        REQUIRE(countersOf("ok").total() == 0);
+
+        const auto all = JsonConfig::diagnostics();
+        REQUIRE(all.size() == 4);
+        REQUIRE(std::is_sorted(all.begin(), all.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.key < rhs.key;
+        }));
+
+        JsonConfig::resetDiagnostics();
+        REQUIRE(JsonConfig::diagnostics().empty());
+    }
+
+    SECTION("once per key") {
+        JsonConfig::DiagnosticsPolicy once;
+        once.mode = Mode::OncePerKey;
+        for (int i = 0; i < 5; ++i) {
+            JsonConfig::getSafe(json_data, "port", 0, once);
+            JsonConfig::getSafe(json_data, "/empty"_json_pointer, 0, once);
+        }
+        REQUIRE(countersOf("port").total() == 5);
+        REQUIRE(countersOf("port").emitted == 1);
+        REQUIRE(countersOf("/empty").emitted == 1);
+    }
+
+    SECTION("rate limited") {
+        JsonConfig::DiagnosticsPolicy limited;
+        limited.mode = Mode::RateLimited;
+        limited.interval = std::chrono::hours(1);
+        for (int i = 0; i < 5; ++i) {
+            JsonConfig::getSafe(json_data, "port", 0, limited);
+        }
+        REQUIRE(countersOf("port").emitted == 1);
+
+        limited.interval = std::chrono::milliseconds(0);
+        JsonConfig::getSafe(json_data, "port", 0, limited);
+        REQUIRE(countersOf("port").emitted == 2);
+        REQUIRE(countersOf("port").total() == 6);
+    }
+
+    SECTION("collect into a report") {
+        JsonConfig::Report report;
+        JsonConfig::DiagnosticsPolicy collect;
+        collect.mode = Mode::Collect;
+        collect.report = &report;
+        REQUIRE(JsonConfig::getSafe(json_data, "port", 7, collect) == 7);
+        REQUIRE(JsonConfig::getSafe(json_data, "missing", 8, collect) == 8);
+        REQUIRE(JsonConfig::getSafe(json_data, "ok", 9, collect) == 1);
+
+        REQUIRE(report.issues.size() == 2);
+        REQUIRE(report.issues[0].key == "port");
+        REQUIRE(report.issues[0].kind == Kind::InvalidType);
+        REQUIRE(report.issues[0].value == "\"not a number\"");
+        REQUIRE(report.issues[1].kind == Kind::Missing);
+        REQUIRE(report.issues[1].value.empty());
+
+        // Repeats of a key and kind add nothing
+        for (int i = 0; i < 100; ++i) {
+            JsonConfig::getSafe(json_data, "port", 7, collect);
+        }
+        JsonConfig::getSafe(json_data, "small", uint8_t{}, collect);
+        REQUIRE(report.issues.size() == 3);
+        REQUIRE(report.issues[2].kind == Kind::OutOfRange);
+        REQUIRE(countersOf("port").total() == 101);
+        REQUIRE(countersOf("port").emitted == 1);
+    }
+
+    SECTION("collected values are truncated") {
+        const nlohmann::json big = {{"blob", std::string(10000, 'x')}};
+        JsonConfig::Report report;
+        JsonConfig::DiagnosticsPolicy collect;
+        collect.mode = Mode::Collect;
+        collect.report = &report;
+        JsonConfig::getSafe(big, "blob", 0, collect);
+        REQUIRE(report.issues.size() == 1);
+        REQUIRE(report.issues[0].value.size() < 300);
+    }
+
+    SECTION("collect from several threads") {
+        JsonConfig::Report report;
+        JsonConfig::DiagnosticsPolicy collect;
+        collect.mode = Mode::Collect;
+        collect.report = &report;
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 1000; ++i) {
+                    JsonConfig::getSafe(json_data, "missing_" + std::to_string(i % 50), 0, collect);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        REQUIRE(report.issues.size() == 50);
+    }
+
+    SECTION("global policy") {
+        JsonConfig::Report report;
+        JsonConfig::DiagnosticsPolicy collect;
+        collect.mode = Mode::Collect;
+        collect.report = &report;
+        JsonConfig::setDiagnosticsPolicy(collect);
+        REQUIRE(JsonConfig::diagnosticsPolicy().mode == Mode::Collect);
+
+        JsonConfig::getSafe<int32_t>(json_data, "missing");
+        JsonConfig::getSafe(json_data, std::string("empty"), 0);
+        JsonConfig::setDiagnosticsPolicy({});
+
+        REQUIRE(report.issues.size() == 2);
+        REQUIRE(JsonConfig::diagnosticsPolicy().mode == Mode::Always);
+    }
+}
@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "msh/utils/byte_array.hpp"
+#include "msh/utils/shared_bytes.hpp"
+
+using namespace msh::utils;
+
+TEST_CASE("SharedBytes: construction", "[SharedBytes]") {
+    SECTION("Default is empty") {
+        SharedBytes bytes;
+        REQUIRE(bytes.empty());
+        REQUIRE(bytes.size() == 0);
+        REQUIRE(bytes.useCount() == 0);
+        REQUIRE(bytes.view().empty());
+    }
+
+    SECTION("Heap buffer is adopted without copying") {
+        ByteArray source(4096, 0x5A);
+        const uint8_t* buffer = source.data();
+
+        SharedBytes bytes(std::move(source));
+        REQUIRE(bytes.data() == buffer);
+        REQUIRE(bytes.size() == 4096);
+        REQUIRE(bytes.useCount() == 1);
+        REQUIRE(source.empty());
+    }
+
+    SECTION("Inline buffer") {
+        SharedBytes bytes(ByteArray({1, 2, 3}));
+        REQUIRE(bytes.size() == 3);
+        REQUIRE(bytes[0] == 1);
+        REQUIRE(bytes.at(2) == 3);
+        REQUIRE_THROWS_AS(bytes.at(3), std::out_of_range);
+    }
+
+    SECTION("From view copies") {
+        const ByteArray source = {0xDE, 0xAD};
+        SharedBytes bytes(source.view());
+        REQUIRE(bytes.data() != source.data());
+        REQUIRE(bytes.view() == source.view());
+        REQUIRE(bytes.toHexString() == "DEAD");
+    }
+}
+
+TEST_CASE("SharedBytes: copies and slices share the buffer", "[SharedBytes]") {
+    SharedBytes bytes(ByteArray(1000, 7));
+
+    SharedBytes copy = bytes;
+    REQUIRE(copy.data() == bytes.data());
+    REQUIRE(bytes.useCount() == 2);
+
+    SharedBytes slice = bytes.slice(100, 50);
+    REQUIRE(slice.data() == bytes.data() + 100);
+    REQUIRE(slice.size() == 50);
+    REQUIRE(bytes.useCount() == 3);
+
+    REQUIRE(bytes.slice(990).size() == 10);
+    REQUIRE(bytes.slice(1000).empty());
+    REQUIRE_THROWS_AS(bytes.slice(1001), std::out_of_range);
+
+    SharedBytes moved = std::move(copy);
+    REQUIRE(copy.empty());
+    REQUIRE(bytes.useCount() == 3);
+
+    moved = SharedBytes();
+    slice = SharedBytes();
+    REQUIRE(bytes.useCount() == 1);
+}
+
+TEST_CASE("SharedBytes: mutation detaches shared buffers", "[SharedBytes]") {
+    SECTION("Unique owner writes in place") {
+        SharedBytes bytes(ByteArray(100, 1));
+        const uint8_t* buffer = bytes.data();
+        bytes.mutableData()[0] = 9;
+        REQUIRE(bytes.data() == buffer);
+        REQUIRE(bytes[0] == 9);
+    }
+
+    SECTION("Shared buffer is copied first") {
+        SharedBytes bytes(ByteArray(100, 1));
+        const SharedBytes other = bytes;
+        bytes.mutableData()[0] = 9;
+        REQUIRE(bytes.data() != other.data());
+        REQUIRE(bytes[0] == 9);
+        REQUIRE(other[0] == 1);
+        REQUIRE(other.useCount() == 1);
+    }
+
+    SECTION("Slice is copied first") {
+        SharedBytes slice = SharedBytes(ByteArray({1, 2, 3, 4})).slice(1, 2);
+        slice.mutableData()[0] = 0;
+        REQUIRE(slice == SharedBytes(ByteArray({0, 3})));
+    }
+
+    SECTION("Release moves a unique buffer out") {
+        SharedBytes bytes(ByteArray(100, 1));
+        const uint8_t* buffer = bytes.data();
+        ByteArray released = bytes.release();
+        REQUIRE(released.data() == buffer);
+        REQUIRE(released.size() == 100);
+        REQUIRE(bytes.empty());
+    }
+
+    SECTION("Release copies a shared buffer") {
+        SharedBytes bytes(ByteArray(100, 1));
+        const SharedBytes other = bytes;
+        ByteArray released = bytes.release();
+        REQUIRE(released.data() != other.data());
+        REQUIRE(released.view() == other.view());
+        REQUIRE(other.useCount() == 1);
+    }
+}
+
+TEST_CASE("SharedBytes: fan-out across threads", "[SharedBytes]") {
+    const SharedBytes payload(ByteArray(1 << 16, 0x42));
+
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < 4; ++i) {
+        consumers.emplace_back([payload]() {
+            for (int round = 0; round < 1000; ++round) {
+                SharedBytes copy = payload;
+                SharedBytes part = copy.slice(static_cast<size_t>(round), 16);
+                REQUIRE(part[15] == 0x42);
+            }
+        });
+    }
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    REQUIRE(payload.useCount() == 1);
+}